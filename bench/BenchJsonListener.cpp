@@ -0,0 +1,74 @@
+// BenchJsonListener.cpp
+
+#include <catch2/catch_all.hpp>
+#include <catch2/reporters/catch_reporter_event_listener.hpp>
+#include <catch2/reporters/catch_reporter_registrars.hpp>
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <nlohmann/json.hpp>
+
+#include "../src/lib/MemoryTracker.hpp"
+
+// Environment variable overriding where the results are written
+static const char* BENCH_JSON_ENV = "NODE_MAZE_BENCH_JSON";
+static const char* BENCH_JSON_DEFAULT = "bench_results.json";
+
+// Collects every BENCHMARK result and writes them as JSON once the run ends, in the format read
+// by scripts/compare_bench.py: {"benchmarks": {"<name>": {"mean_ns": ..., ...}}}. The memory
+// accounting of the whole run is printed and stored next to them under "memory".
+class BenchJsonListener : public Catch::EventListenerBase {
+ public:
+    using Catch::EventListenerBase::EventListenerBase;
+
+    void testRunStarting(Catch::TestRunInfo const&) override {
+        if (!installEcsMemoryHooks()) {
+            std::cerr << "flecs was initialized before the memory hooks, ECS allocations are not tracked" << std::endl;
+        }
+    }
+
+    void benchmarkEnded(Catch::BenchmarkStats const& stats) override {
+        results_[stats.info.name] = {
+            {"mean_ns", stats.mean.point.count()},
+            {"mean_low_ns", stats.mean.lower_bound.count()},
+            {"mean_high_ns", stats.mean.upper_bound.count()},
+            {"stddev_ns", stats.standardDeviation.point.count()},
+            {"samples", stats.info.samples},
+            {"iterations", stats.info.iterations}
+        };
+    }
+
+    void testRunEnded(Catch::TestRunStats const&) override {
+        if (results_.empty()) return;
+
+        std::vector<MemoryStats> report = MemoryTracker::report();
+        printMemoryReport(std::cout, report);
+        nlohmann::json memory = nlohmann::json::object();
+        for (const MemoryStats& stats : report) {
+            memory[stats.name] = {
+                {"live_bytes", stats.live_bytes},
+                {"peak_bytes", stats.peak_bytes},
+                {"allocations", stats.allocations}
+            };
+        }
+
+        const char* path = std::getenv(BENCH_JSON_ENV);
+        std::string output = path != nullptr && *path != '\0' ? path : BENCH_JSON_DEFAULT;
+
+        std::ofstream file(output);
+        if (!file.is_open()) {
+            std::cerr << "Could not write benchmark results: " << output << std::endl;
+            return;
+        }
+        file << nlohmann::json({{"benchmarks", results_}, {"memory", memory}}).dump(2) << std::endl;
+        std::cout << "Benchmark results written to " << output << std::endl;
+    }
+
+ private:
+    nlohmann::json results_ = nlohmann::json::object();
+};
+
+CATCH_REGISTER_LISTENER(BenchJsonListener)
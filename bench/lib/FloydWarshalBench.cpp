@@ -0,0 +1,60 @@
+// FloydWarshalBench.cpp
+
+#include <catch2/catch_all.hpp>
+
+#include <string>
+#include <vector>
+
+#include "FloydWarshal.hpp"
+#include "JobSystem.hpp"
+
+// Ring plus deterministic shortcuts, every node reaches every other node
+static FloydWarshal makeGraph(unsigned size) {
+    FloydWarshal graph(size);
+    graph.clean();
+    for (unsigned i = 0; i < size; ++i) {
+        graph.addEdge(i, (i + 1) % size, (i * 7) % 5 + 1);
+        unsigned shortcut = (i * 13 + 5) % size;
+        if (shortcut != i) {
+            graph.addEdge(i, shortcut, (i * 3) % 7 + 2);
+        }
+    }
+    return graph;
+}
+
+TEST_CASE("FloydWarshal generate", "[bench][FloydWarshal]") {
+    JobSystem jobs;
+
+    for (unsigned size : {32u, 128u, 256u}) {
+        const FloydWarshal base = makeGraph(size);
+
+        BENCHMARK_ADVANCED("FloydWarshal::generate/" + std::to_string(size))(Catch::Benchmark::Chronometer meter) {
+            std::vector<FloydWarshal> graphs(meter.runs(), base);
+            meter.measure([&graphs](int run) { graphs[run].generate(); });
+        };
+
+        BENCHMARK_ADVANCED("FloydWarshal::generate(jobs)/" + std::to_string(size))(
+            Catch::Benchmark::Chronometer meter) {
+            std::vector<FloydWarshal> graphs(meter.runs(), base);
+            meter.measure([&graphs, &jobs](int run) { graphs[run].generate(jobs); });
+        };
+    }
+}
+
+TEST_CASE("FloydWarshal queries", "[bench][FloydWarshal]") {
+    for (unsigned size : {32u, 128u, 256u}) {
+        FloydWarshal graph = makeGraph(size);
+        graph.generate();
+
+        BENCHMARK("FloydWarshal::value+next/" + std::to_string(size)) {
+            unsigned total = 0;
+            for (unsigned i = 0; i < size; ++i) {
+                unsigned target = (i * 31 + 7) % size;
+                if (graph.hasPath(i, target)) {
+                    total += graph.value(i, target) + graph.next(i, target);
+                }
+            }
+            return total;
+        };
+    }
+}
@@ -0,0 +1,51 @@
+// QuadTreeBench.cpp
+
+#include <catch2/catch_all.hpp>
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include "QuadTree.hpp"
+
+static const float WORLD_SIZE = 4096.0f;
+
+static std::vector<EntityPosition> makePositions(unsigned count) {
+    std::mt19937 random(count);
+    std::uniform_real_distribution<float> coordinate(0.0f, WORLD_SIZE);
+
+    std::vector<EntityPosition> positions(count);
+    for (unsigned i = 0; i < count; ++i) {
+        positions[i] = {i, coordinate(random), coordinate(random)};
+    }
+    return positions;
+}
+
+static QuadTree makeTree(const std::vector<EntityPosition>& positions) {
+    QuadTree tree({0.0f, 0.0f, WORLD_SIZE, WORLD_SIZE});
+    for (const auto& position : positions) {
+        tree.insert(position);
+    }
+    return tree;
+}
+
+TEST_CASE("QuadTree build", "[bench][QuadTree]") {
+    for (unsigned count : {100u, 1000u, 10000u}) {
+        const auto positions = makePositions(count);
+
+        BENCHMARK("QuadTree::insert/" + std::to_string(count)) {
+            return makeTree(positions);
+        };
+    }
+}
+
+TEST_CASE("QuadTree query", "[bench][QuadTree]") {
+    for (unsigned count : {100u, 1000u, 10000u}) {
+        QuadTree tree = makeTree(makePositions(count));
+
+        // A screen sized window in the middle of the world
+        BENCHMARK("QuadTree::query/" + std::to_string(count)) {
+            return tree.query({WORLD_SIZE / 2, WORLD_SIZE / 2, 800.0f, 450.0f});
+        };
+    }
+}
@@ -0,0 +1,90 @@
+// RendererBench.cpp
+
+#include <catch2/catch_all.hpp>
+
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "HeadlessBackend.hpp"
+#include "Renderer.hpp"
+
+// Benchmarks run from the build directory, like the tests
+static const std::string FIXTURES_PATH = "../test/fixtures/";
+static const std::string RESOURCES_PATH = "../resources/";
+
+static void spawn(flecs::world& ecs, Renderer& renderer, unsigned count) {
+    const MappingPosition& sprite = renderer.getSpriteMap().at("job1/m_bald_0001");
+    for (unsigned i = 0; i < count; ++i) {
+        ecs.entity()
+            .set<Render>({
+                .z_index = static_cast<int>(i % 8),
+                .position = { static_cast<float>(i % 100) * 8.0f, static_cast<float>(i / 100) * 8.0f },
+                .sprite = sprite })
+            .set<Animation>({
+                .name = "job1/m_bald_0001",
+                .actual_frame = 1,
+                .total_frames = 8,
+                .current_frame = static_cast<float>(i % 10) * 0.02f });
+    }
+}
+
+TEST_CASE("Renderer atlas parsing", "[bench][Renderer]") {
+    std::vector<std::tuple<std::string, std::string>> atlases = {
+        {"fixture", FIXTURES_PATH + "characters.json"},
+        {"characters", RESOURCES_PATH + "characters.json"},
+        {"rooms", RESOURCES_PATH + "rooms.json"}
+    };
+
+    for (const auto& [name, path] : atlases) {
+        BENCHMARK("Renderer::Renderer/" + name) {
+            return Renderer({{CHARACTERS, path}});
+        };
+    }
+}
+
+TEST_CASE("Animation system", "[bench][Renderer]") {
+    for (unsigned count : {100u, 1000u, 10000u}) {
+        Renderer renderer({{CHARACTERS, RESOURCES_PATH + "characters.json"}});
+        flecs::world ecs;
+        renderer.RegisterAnimationSystem(&ecs);
+        spawn(ecs, renderer, count);
+
+        BENCHMARK("Animation system/" + std::to_string(count)) {
+            return ecs.progress(1.0f / 60.0f);
+        };
+    }
+}
+
+// The view covers a tenth of the spawned rows, the rest of the world is off screen
+TEST_CASE("Animation system with a view", "[bench][Renderer]") {
+    for (unsigned count : {1000u, 10000u}) {
+        Renderer renderer({{CHARACTERS, RESOURCES_PATH + "characters.json"}});
+        renderer.setView({0.0f, 0.0f, 800.0f, static_cast<float>(count / 100) * 0.8f});
+        flecs::world ecs;
+        renderer.RegisterAnimationSystem(&ecs);
+        spawn(ecs, renderer, count);
+
+        BENCHMARK("Animation system (view)/" + std::to_string(count)) {
+            return ecs.progress(1.0f / 60.0f);
+        };
+    }
+}
+
+TEST_CASE("Render system", "[bench][Renderer]") {
+    for (unsigned count : {100u, 1000u, 10000u}) {
+        HeadlessBackend backend;
+        Renderer renderer({{CHARACTERS, RESOURCES_PATH + "characters.json"}}, &backend);
+        renderer.LoadTextures({{CHARACTERS, RESOURCES_PATH + "characters.png"}});
+        flecs::world ecs;
+        renderer.RegisterRenderSystem(&ecs);
+        spawn(ecs, renderer, count);
+
+        BENCHMARK("Render system (headless)/" + std::to_string(count)) {
+            backend.beginFrame();
+            ecs.progress(1.0f / 60.0f);
+            backend.endFrame();
+            return backend.commands().size();
+        };
+    }
+}
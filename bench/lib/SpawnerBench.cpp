@@ -0,0 +1,68 @@
+// SpawnerBench.cpp
+
+#include <catch2/catch_all.hpp>
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Spawner.hpp"
+
+static const Render TEMPLATE_RENDER = { .z_index = 0, .position = { 0.0f, 0.0f }, .sprite = { .width = 26, .height = 61 } };
+static const Animation TEMPLATE_ANIMATION = {
+    .name = "job1/m_bald_0001", .actual_frame = 1, .total_frames = 8, .current_frame = 0.0f };
+
+static void makeArrays(unsigned count, std::vector<Render>* renders, std::vector<Animation>* animations) {
+    renders->assign(count, TEMPLATE_RENDER);
+    animations->assign(count, TEMPLATE_ANIMATION);
+    for (unsigned i = 0; i < count; ++i) {
+        (*renders)[i].z_index = static_cast<int>(i % 8);
+        (*renders)[i].position = { static_cast<float>(i % 100) * 8.0f, static_cast<float>(i / 100) * 8.0f };
+        (*animations)[i].current_frame = static_cast<float>(i % 10) * 0.02f;
+    }
+}
+
+// Every run spawns into a fresh world with fresh arrays, both are prepared outside of the measurement.
+// The bulk spawns move the animations in, the per entity sets copy them, which is what they cost.
+TEST_CASE("Spawn", "[bench][Spawner]") {
+    for (unsigned count : {1000u, 10000u}) {
+        std::vector<Render> renders;
+        std::vector<Animation> animations;
+        makeArrays(count, &renders, &animations);
+
+        BENCHMARK_ADVANCED("Spawn per entity set/" + std::to_string(count))(Catch::Benchmark::Chronometer meter) {
+            std::vector<std::unique_ptr<flecs::world>> worlds(meter.runs());
+            for (auto& ecs : worlds) {
+                ecs = std::make_unique<flecs::world>();
+                ecs->component<Render>();
+                ecs->component<Animation>();
+            }
+            meter.measure([&](int run) {
+                flecs::world& ecs = *worlds[run];
+                for (unsigned i = 0; i < count; ++i) {
+                    ecs.entity()
+                        .set<Render>(renders[i])
+                        .set<Animation>(animations[i]);
+                }
+                return ecs.count<Render>();
+            });
+        };
+
+        BENCHMARK_ADVANCED("Spawn bulk/" + std::to_string(count))(Catch::Benchmark::Chronometer meter) {
+            std::vector<std::unique_ptr<flecs::world>> worlds(meter.runs());
+            std::vector<std::unique_ptr<Spawner>> spawners(meter.runs());
+            std::vector<flecs::entity> prefabs(meter.runs());
+            std::vector<std::vector<Animation>> run_animations(meter.runs());
+            for (int run = 0; run < meter.runs(); ++run) {
+                worlds[run] = std::make_unique<flecs::world>();
+                spawners[run] = std::make_unique<Spawner>(worlds[run].get());
+                prefabs[run] = spawners[run]->prefab("Character", TEMPLATE_RENDER, TEMPLATE_ANIMATION);
+                run_animations[run] = animations;
+            }
+            meter.measure([&](int run) {
+                return spawners[run]->spawn(prefabs[run], renders, std::move(run_animations[run])).size();
+            });
+        };
+    }
+}
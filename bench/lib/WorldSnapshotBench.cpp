@@ -0,0 +1,76 @@
+// WorldSnapshotBench.cpp
+
+#include <catch2/catch_all.hpp>
+
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "Spawner.hpp"
+#include "WorldSnapshot.hpp"
+
+static const unsigned PATH_NODES = 128;
+
+struct Level {
+    std::vector<Render> renders;
+    std::vector<Animation> animations;
+};
+
+static Level makeLevel(unsigned count) {
+    Level level;
+    level.renders.resize(count);
+    level.animations.resize(count);
+    for (unsigned i = 0; i < count; ++i) {
+        level.renders[i] = {
+            .z_index = static_cast<int>(i % 8),
+            .position = { static_cast<float>(i % 100) * 8.0f, static_cast<float>(i / 100) * 8.0f },
+            .sprite = { .width = 26, .height = 61 } };
+        level.animations[i] = { .name = "job1/m_bald_0001", .actual_frame = 1, .total_frames = 8 };
+    }
+    return level;
+}
+
+// What a level start does without a snapshot: spawn, index and generate the paths
+static void buildLevel(const Level& level, flecs::world* ecs, QuadTree* tree, FloydWarshal* paths) {
+    Spawner(ecs).spawn(level.renders, level.animations);
+
+    tree->reset({-20.0f, -20.0f, 840.0f, 840.0f});
+    ecs->each([tree](flecs::entity entity, const Render& render) {
+        tree->insert({static_cast<uint32_t>(entity.id()), render.position.x, render.position.y});
+    });
+
+    paths->clean();
+    for (unsigned node = 0; node + 1 < PATH_NODES; ++node) {
+        paths->addEdge(node, node + 1, 1);
+        paths->addEdge(node + 1, node, 1);
+    }
+    paths->generate();
+}
+
+TEST_CASE("World snapshot", "[bench][WorldSnapshot]") {
+    for (unsigned count : {1000u, 10000u}) {
+        Level level = makeLevel(count);
+        std::string path = (std::filesystem::temp_directory_path() /
+                            ("node_maze_bench_" + std::to_string(count) + ".nmws")).string();
+
+        flecs::world ecs;
+        QuadTree tree({0.0f, 0.0f, 0.0f, 0.0f});
+        FloydWarshal paths(PATH_NODES);
+        buildLevel(level, &ecs, &tree, &paths);
+        std::string error;
+
+        BENCHMARK("Level rebuild/" + std::to_string(count)) {
+            ecs.delete_with<Render>();
+            buildLevel(level, &ecs, &tree, &paths);
+            return ecs.count<Render>();
+        };
+
+        BENCHMARK("WorldSnapshot::save/" + std::to_string(count)) {
+            return WorldSnapshot::save(path, &ecs, &tree, &paths, {}, &error);
+        };
+
+        BENCHMARK("WorldSnapshot::load/" + std::to_string(count)) {
+            return WorldSnapshot::load(path, &ecs, &tree, &paths, {}, &error);
+        };
+    }
+}
@@ -0,0 +1,73 @@
+#!/usr/bin/env python3
+"""Compares node_maze_bench results against a stored baseline.
+
+Both files use the format written by bench/BenchJsonListener.cpp. Exits with 1 when any
+benchmark got slower than the baseline by more than the threshold, so it can gate CI, and when
+there is no baseline to compare with (record one with --update).
+
+    python3 scripts/compare_bench.py bench/baseline.json build/bench_results.json --threshold 10
+    python3 scripts/compare_bench.py bench/baseline.json build/bench_results.json --update
+"""
+
+import argparse
+import json
+import os
+import shutil
+import sys
+
+
+def load(path):
+    with open(path, encoding="utf-8") as file:
+        return json.load(file)["benchmarks"]
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("baseline", help="stored baseline JSON")
+    parser.add_argument("current", help="JSON written by node_maze_bench")
+    parser.add_argument("--threshold", type=float, default=10.0,
+                        help="allowed slowdown of the mean in percent (default: 10)")
+    parser.add_argument("--update", action="store_true", help="replace the baseline with the current results")
+    args = parser.parse_args()
+
+    if args.update:
+        shutil.copyfile(args.current, args.baseline)
+        print(f"Baseline {args.baseline} updated from {args.current}")
+        return 0
+
+    if not os.path.exists(args.baseline):
+        print(f"No baseline at {args.baseline}, record one with --update", file=sys.stderr)
+        return 1
+
+    baseline = load(args.baseline)
+    current = load(args.current)
+
+    regressions = 0
+    width = max((len(name) for name in current), default=0)
+    for name in sorted(current):
+        mean = current[name]["mean_ns"]
+        if name not in baseline:
+            print(f"{name:<{width}}  {mean / 1000:12.2f} us  (new)")
+            continue
+
+        base = baseline[name]["mean_ns"]
+        change = (mean - base) / base * 100.0 if base > 0 else 0.0
+        status = "ok"
+        if change > args.threshold:
+            status = "REGRESSION"
+            regressions += 1
+        elif change < -args.threshold:
+            status = "improved"
+        print(f"{name:<{width}}  {mean / 1000:12.2f} us  {change:+8.1f}%  {status}")
+
+    for name in sorted(set(baseline) - set(current)):
+        print(f"{name:<{width}}  missing from the current results")
+
+    if regressions:
+        print(f"{regressions} benchmark(s) slower than the baseline by more than {args.threshold}%")
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -25,6 +25,7 @@ struct Animation {
     unsigned actual_frame = 0;
     unsigned total_frames = 0;
     float current_frame = 0.0f;
+    float synced_at = -1.0f;  // World time the animation was last advanced to, negative before the first update
 };
 
 struct Render {
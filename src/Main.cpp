@@ -18,11 +18,27 @@
 #include <cmath>
 #include <iostream>
 #include <map>
+#include <memory>
+#include <vector>
 
 #include "boost/di.hpp"
 #include "boost/sml.hpp"
 #include "boost/sml/utility/dispatch_table.hpp"
+#include "lib/AllocationCounter.hpp"
+#include "lib/FrameArena.hpp"
+#include "lib/Game.hpp"
+#include "lib/InputLog.hpp"
+#include "lib/JobSystem.hpp"
+#include "lib/LiveInput.hpp"
+#include "lib/MemoryTracker.hpp"
+#include "lib/Profiler.hpp"
+#include "lib/ProfilerOverlay.hpp"
+#include "lib/RaylibBackend.hpp"
 #include "lib/Renderer.hpp"
+#include "lib/Replay.hpp"
+#include "lib/SpatialIndex.hpp"
+#include "lib/Stress.hpp"
+#include "lib/Workers.hpp"
 
 #include "Components.hpp"
 #include "raylib.h"
@@ -30,47 +46,84 @@
 
 const int CHARACTER_IDLE_WIDTH = 32;
 const int CHARACTER_IDLE_HEIGHT = 32;
-const int screenWidth = 800;
-const int screenHeight = 450;
 const int TARGET_FPS = 120;
 
 #ifdef _WIN32
 int WinMain() {
+    int argc = __argc;
+    char** argv = __argv;
 #else
-int main() {
+int main(int argc, char** argv) {
 #endif
+    // Before any flecs world exists, flecs keeps the allocator it was initialized with
+    if (!installEcsMemoryHooks()) {
+        std::cerr << "flecs was initialized before the memory hooks, ECS allocations are not tracked" << std::endl;
+    }
+    std::string budgetError;
+    if (!applyMemoryBudgets(std::getenv(MEMORY_BUDGET_ENV), &budgetError)) {
+        std::cerr << budgetError << std::endl;
+        return 1;
+    }
+
+    // Zones are only recorded while the profiler is enabled: NODE_MAZE_TRACE or the F3 overlay
+    const char* tracePath = std::getenv(TRACE_ENV);
+    Profiler& profiler = Profiler::instance();
+    profiler.setEnabled(tracePath != nullptr);
+    bool showProfiler = false;
+
+    // Headless capacity run: node_maze --stress --entities 10000 --frames 600
+    StressOptions stressOptions;
+    std::string stressError;
+    if (parseStressOptions(argc, argv, &stressOptions, &stressError)) {
+        if (!stressError.empty()) {
+            std::cerr << stressError << std::endl;
+            return 1;
+        }
+        StressReport stressReport = runStress(stressOptions);
+        printStressReport(std::cout, stressReport);
+        if (tracePath != nullptr) {
+            profiler.exportChromeTrace(tracePath);
+        }
+        return stressReport.error.empty() ? 0 : 1;
+    }
+
+    // Deterministic playback of a recording: node_maze --replay session.nmil
+    ReplayOptions replayOptions;
+    std::string replayError;
+    if (parseReplayOptions(argc, argv, &replayOptions, &replayError)) {
+        if (!replayError.empty()) {
+            std::cerr << replayError << std::endl;
+            return 1;
+        }
+        ReplayReport replayReport = runReplay(replayOptions);
+        printReplayReport(std::cout, replayReport);
+        return replayReport.error.empty() && !replayReport.diverged ? 0 : 1;
+    }
+
+    // Records the session for --replay: node_maze --record session.nmil
+    std::string recordError;
+    const char* recordPath = parseRecordPath(argc, argv, &recordError);
+    if (!recordError.empty()) {
+        std::cerr << recordError << std::endl;
+        return 1;
+    }
+
+    // Every draw call of the frame goes through the backend
+    RaylibBackend backend;
     Renderer renderer = Renderer({
         {CHARACTERS, "resources/characters.json"},
-    });
+    }, &backend);
 
-    // Instantiate an ECS world
+    // Instantiate an ECS world, multi threaded systems are spread over the worker threads
     flecs::world ecsWorld;
+    ecsWorld.set_threads(static_cast<int32_t>(resolveWorkerCount(std::getenv(WORKERS_ENV))));
+
+    // Register components and create the entities with Render and Animation components
+    GameState game = createGame(&ecsWorld, &renderer);
 
-    // Register components
-    ecsWorld.component<Render>();
-    ecsWorld.component<Animation>();
-
-    // Create a new entity with Render and Animation components
-    ecsWorld.entity()
-        .set<Render>(
-            {
-                .z_index = 1,
-                .position = { static_cast<float>(screenWidth)/3, static_cast<float>(screenHeight)/3 },
-                .sprite = renderer.getSpriteMap().at("attack/thief_0001")
-            }
-        )
-        .set<Animation>({ .name = "job1/m_bald_0001", .actual_frame = 1, .total_frames = 8, .current_frame = 0.0f });
-
-    // Create a new entity with Render and Animation components
-    auto entity = ecsWorld.entity()
-        .set<Render>(
-            {
-                .z_index = 2,
-                .position = { static_cast<float>(screenWidth)/3 + 5, static_cast<float>(screenHeight)/3 + 5 },
-                .sprite = renderer.getSpriteMap().at("attack/thief_0001")
-            }
-        )
-        .set<Animation>({ .name = "job1/w_blonde_0001", .actual_frame = 1, .total_frames = 8, .current_frame = 0.0f });
+    // Background jobs overlap with the simulation and the rendering of a frame
+    JobSystem jobs;
+    SpatialIndex spatialIndex;
 
     // Number of entities on the world
     std::cout << "Entities with Render component: " << ecsWorld.count<Render>() << std::endl;
@@ -81,59 +134,120 @@ int main() {
     //--------------------------------------------------------------------------------------
 
     Image image = LoadImage("resources/icon.png");
-    InitWindow(screenWidth, screenHeight, "Simple Raylib Game");
+    InitWindow(SCREEN_WIDTH, SCREEN_HEIGHT, "Simple Raylib Game");
     SetWindowIcon(image);
 
     renderer.LoadTextures({
         {CHARACTERS, "resources/characters.png"},
     });
 
-    Vector2 ballPosition = {
-        static_cast<float>(screenWidth)/2,
-        static_cast<float>(screenHeight)/2
-    };
-
-    const float BALL_SPEED = 5.0f;
-    const float BALL_RADIUS = 50.0f;
-    float ballSpeed = BALL_SPEED;
-
-
     SetTargetFPS(TARGET_FPS);
+
+    // A recording advances every frame by a fixed step so it replays identically at full speed
+    const float RECORD_STEP = 1.0f / TARGET_FPS;
+    LiveInput liveInput(recordPath != nullptr ? RECORD_STEP : 0.0f);
+    std::unique_ptr<InputRecorder> recorder;
+    IInputSource* input = &liveInput;
+    if (recordPath != nullptr) {
+        recorder = std::make_unique<InputRecorder>(&liveInput, recordPath, RECORD_STEP);
+        if (!recorder->good()) {
+            std::cerr << "Could not write input log: " << recordPath << std::endl;
+            return 1;
+        }
+        input = recorder.get();
+    }
+    FrameInput frameInput;
     //--------------------------------------------------------------------------------------
 
     const int TEXT_POSITION_X = 10;
     const int TEXT_POSITION_Y = 10;
     const int TEXT_FONT_SIZE = 20;
+    const int PROFILER_POSITION_Y = 40;
+    const int ALLOCATIONS_POSITION_Y = 25;
+    const int ALLOCATIONS_FONT_SIZE = 10;
+    uint64_t frameAllocations = 0;
+    char allocationsText[64];
+    std::vector<ZoneStats> zoneStats;  // Reused by the overlay every frame
 
     // Main game loop
     while (!WindowShouldClose()) {    // Detect window close button or ESC key
+        PROFILE_ZONE("Frame");
+        uint64_t allocationsAtStart = heapAllocations();
         // Update
         //----------------------------------------------------------------------------------
-        if (IsKeyDown(KEY_RIGHT)) ballPosition.x += ballSpeed;
-        if (IsKeyDown(KEY_LEFT)) ballPosition.x -= ballSpeed;
-        if (IsKeyDown(KEY_UP)) ballPosition.y -= ballSpeed;
-        if (IsKeyDown(KEY_DOWN)) ballPosition.y += ballSpeed;
-        ecsWorld.progress();
+        input->poll(&frameInput);
+        if (frameInput.keys & INPUT_TOGGLE_PROFILER) {
+            showProfiler = !showProfiler;
+            profiler.setEnabled(showProfiler || tracePath != nullptr);
+        }
+        updateGame(&game, frameInput);
+        applyCheckpointInput(frameInput, CHECKPOINT_PATH, &game, &ecsWorld);
+        JobHandle indexed = spatialIndex.ExecuteAsync(&ecsWorld, &jobs);
         //----------------------------------------------------------------------------------
 
         // Draw
         //----------------------------------------------------------------------------------
-        BeginDrawing();
+        {
+            PROFILE_ZONE("BeginDrawing");
+            backend.beginFrame();
+        }
+
+        backend.clear(RAYWHITE);
+
+        // Simulation systems run on the workers, the render system draws on this thread at OnStore
+        {
+            PROFILE_ZONE("ecsWorld.progress");
+            ecsWorld.progress(frameInput.delta_time);
+        }
 
-        ClearBackground(RAYWHITE);
-        DrawText("Move the ball with arrow keys",
+        backend.drawText("Move the ball with arrow keys",
             TEXT_POSITION_X, TEXT_POSITION_Y,
             TEXT_FONT_SIZE,
             DARKGRAY);
-        DrawCircleV(ballPosition, BALL_RADIUS, MAROON);
-
-        EndDrawing();
+        backend.drawCircle(game.ball_position, BALL_RADIUS, MAROON);
+
+        if (showProfiler) {
+            std::snprintf(allocationsText, sizeof(allocationsText), "Heap allocations last frame: %llu",
+                          static_cast<unsigned long long>(frameAllocations));
+            backend.drawText(allocationsText, TEXT_POSITION_X, ALLOCATIONS_POSITION_Y, ALLOCATIONS_FONT_SIZE, DARKGRAY);
+            profiler.stats(&zoneStats);
+            drawProfilerOverlay(&backend, zoneStats, TEXT_POSITION_X, PROFILER_POSITION_Y);
+        }
+
+        {
+            PROFILE_ZONE("EndDrawing");
+            backend.endFrame();
+        }
+
+        {
+            PROFILE_ZONE("Wait jobs");
+            jobs.wait(indexed);
+        }
+        profiler.collect();
+
+        if (recorder && recorder->frames() % CHECKPOINT_INTERVAL == 0) {
+            recorder->checkpoint(hashGame(game, &ecsWorld));
+        }
+
+        // Workers are idle, every transient allocation of the frame is released at once
+        FrameArena::resetAll();
+        frameAllocations = heapAllocations() - allocationsAtStart;
         //----------------------------------------------------------------------------------
     }
 
     // De-Initialization
     //--------------------------------------------------------------------------------------
     CloseWindow();        // Close window and OpenGL context
+
+    if (recorder) {
+        recorder->checkpoint(hashGame(game, &ecsWorld));
+        std::cout << "Recorded " << recorder->frames() << " frames to " << recordPath << std::endl;
+    }
+
+    if (tracePath != nullptr) {
+        profiler.collect();
+        profiler.exportChromeTrace(tracePath);
+    }
     //--------------------------------------------------------------------------------------
 
     return 0;
@@ -0,0 +1,13 @@
+#ifndef SRC_INTERFACES_IEXECUTESASYNC_HPP_
+#define SRC_INTERFACES_IEXECUTESASYNC_HPP_
+
+#include "flecs.h"
+#include "../lib/JobSystem.hpp"
+
+// Interface class for actions that run as jobs, the returned handle completes with the action
+class IExecutesAsync {
+ public:
+    virtual JobHandle ExecuteAsync(flecs::world* ecs, JobSystem* jobs) = 0;  // Pure virtual function
+};
+
+#endif  // SRC_INTERFACES_IEXECUTESASYNC_HPP_
@@ -0,0 +1,29 @@
+#ifndef SRC_INTERFACES_IINPUTSOURCE_HPP_
+#define SRC_INTERFACES_IINPUTSOURCE_HPP_
+
+#include <cstdint>
+
+// Bits of FrameInput::keys, the arrows are held keys, the others presses
+enum InputKey : uint8_t {
+    INPUT_RIGHT = 1 << 0,
+    INPUT_LEFT = 1 << 1,
+    INPUT_UP = 1 << 2,
+    INPUT_DOWN = 1 << 3,
+    INPUT_TOGGLE_PROFILER = 1 << 4,
+    INPUT_SAVE_CHECKPOINT = 1 << 5,
+    INPUT_LOAD_CHECKPOINT = 1 << 6
+};
+
+struct FrameInput {
+    uint8_t keys = 0;
+    float delta_time = 0.0f;
+};
+
+// Interface class for the input and the time step of every frame
+class IInputSource {
+ public:
+    virtual ~IInputSource() = default;
+    virtual bool poll(FrameInput* input) = 0;  // False once the source has no more frames
+};
+
+#endif  // SRC_INTERFACES_IINPUTSOURCE_HPP_
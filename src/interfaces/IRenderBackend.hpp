@@ -0,0 +1,26 @@
+#ifndef SRC_INTERFACES_IRENDERBACKEND_HPP_
+#define SRC_INTERFACES_IRENDERBACKEND_HPP_
+
+#include <string>
+
+#include "raylib.h"
+
+// Interface class for the drawing calls of a frame, so rendering can run without a GPU
+class IRenderBackend {
+ public:
+    virtual ~IRenderBackend() = default;
+
+    virtual Texture2D loadTexture(const std::string& path) = 0;
+    virtual void unloadTexture(Texture2D texture) = 0;
+
+    virtual void beginFrame() = 0;
+    virtual void endFrame() = 0;
+
+    virtual void clear(Color color) = 0;
+    virtual void drawTexture(Texture2D texture, Rectangle source, Rectangle dest,
+                             Vector2 origin, float rotation, Color tint) = 0;
+    virtual void drawText(const char* text, int x, int y, int font_size, Color color) = 0;
+    virtual void drawCircle(Vector2 center, float radius, Color color) = 0;
+};
+
+#endif  // SRC_INTERFACES_IRENDERBACKEND_HPP_
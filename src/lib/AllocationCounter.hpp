@@ -0,0 +1,12 @@
+// AllocationCounter.hpp
+
+#ifndef SRC_LIB_ALLOCATIONCOUNTER_HPP_
+#define SRC_LIB_ALLOCATIONCOUNTER_HPP_
+
+#include <cstdint>
+
+// Number of global operator new calls since start. Counted by the replacement operators in
+// AllocationCounter.cpp, so it stays at zero in targets that do not link that file.
+uint64_t heapAllocations();
+
+#endif  // SRC_LIB_ALLOCATIONCOUNTER_HPP_
@@ -1,6 +1,10 @@
 // FloydWarshal.cpp
 
 #include "FloydWarshal.hpp"
+#include "JobSystem.hpp"
+#include "Profiler.hpp"
+
+static const size_t ROWS_PER_JOB = 16;
 
 FloydWarshal::FloydWarshal(unsigned size) : size(size) {
     clean();
@@ -66,8 +70,8 @@ void FloydWarshal::clean() {
     last_key = 0;
     ids.clear();
 
-    graph.assign(size, std::vector<unsigned>(size, INF));
-    path.assign(size, std::vector<unsigned>(size));
+    graph.assign(size, Row(size, INF));
+    path.assign(size, Row(size));
 
     for (unsigned i = 0; i < size; ++i) {
         for (unsigned j = 0; j < size; ++j) {
@@ -80,6 +84,7 @@ void FloydWarshal::clean() {
 }
 
 void FloydWarshal::generate() {
+    PROFILE_ZONE("FloydWarshal::generate");
     for (unsigned k = 0; k < size; ++k) {
         for (unsigned i = 0; i < size; ++i) {
             for (unsigned j = 0; j < size; ++j) {
@@ -93,6 +98,27 @@ void FloydWarshal::generate() {
     }
 }
 
+void FloydWarshal::generate(JobSystem& jobs) {
+    PROFILE_ZONE("FloydWarshal::generate(jobs)");
+    // Row k and column k do not change during step k, so rows can be relaxed independently
+    for (unsigned k = 0; k < size; ++k) {
+        jobs.parallelFor(0, size, ROWS_PER_JOB, [this, k](size_t first, size_t last) {
+            const Row& row_k = graph[k];
+            for (size_t i = first; i < last; ++i) {
+                Row& row_i = graph[i];
+                unsigned through_k = row_i[k];
+                if (through_k == INF) continue;
+                for (unsigned j = 0; j < size; ++j) {
+                    if (row_k[j] != INF && through_k + row_k[j] < row_i[j]) {
+                        row_i[j] = through_k + row_k[j];
+                        path[i][j] = path[i][k];
+                    }
+                }
+            }
+        });
+    }
+}
+
 unsigned FloydWarshal::getSize() const {
     return size;
 }
@@ -8,6 +8,10 @@
 #include <limits>
 #include <iostream>
 
+#include "MemoryTracker.hpp"
+
+class JobSystem;
+
 class FloydWarshal {
 public:
     static constexpr unsigned INF = std::numeric_limits<unsigned>::max();
@@ -28,14 +32,24 @@ public:
 
     void clean();
     void generate();
+    // Same result as generate(), the rows of every k step are relaxed in parallel
+    void generate(JobSystem& jobs);
 
     unsigned getSize() const;
 
 private:
+    friend class WorldSnapshot;  // Writes and restores the matrices row by row
+
+    // Both N x N matrices and the id mapping are accounted to MemoryTag::PATHFINDING
+    using Row = std::vector<unsigned, TrackedAllocator<unsigned, MemoryTag::PATHFINDING>>;
+    using Matrix = std::vector<Row, TrackedAllocator<Row, MemoryTag::PATHFINDING>>;
+    using IdMap = std::unordered_map<unsigned, unsigned, std::hash<unsigned>, std::equal_to<unsigned>,
+                                     TrackedAllocator<std::pair<const unsigned, unsigned>, MemoryTag::PATHFINDING>>;
+
     unsigned size;
-    std::vector<std::vector<unsigned>> graph;
-    std::vector<std::vector<unsigned>> path;
-    std::unordered_map<unsigned, unsigned> ids;
+    Matrix graph;
+    Matrix path;
+    IdMap ids;
     unsigned last_key = 0;
 
     unsigned newKey();
@@ -0,0 +1,106 @@
+// FrameArena.cpp
+
+#include "FrameArena.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <mutex>
+
+static std::mutex registry_mutex;
+static std::vector<FrameArena*> registry;
+
+FrameArena::FrameArena(size_t capacity) {
+    addChunk(std::max<size_t>(capacity, 1));
+}
+
+FrameArena::~FrameArena() {
+    std::lock_guard<std::mutex> lock(registry_mutex);
+    registry.erase(std::remove(registry.begin(), registry.end(), this), registry.end());
+}
+
+void FrameArena::reset() {
+    if (chunks_.size() > 1) {
+        size_t total = 0;
+        for (const auto& chunk : chunks_) {
+            total += chunk.size;
+        }
+        chunks_.clear();
+        addChunk(total);
+    }
+    offset_ = 0;
+    used_ = 0;
+}
+
+size_t FrameArena::used() const {
+    return used_;
+}
+
+size_t FrameArena::peak() const {
+    return peak_;
+}
+
+size_t FrameArena::capacity() const {
+    size_t total = 0;
+    for (const auto& chunk : chunks_) {
+        total += chunk.size;
+    }
+    return total;
+}
+
+size_t FrameArena::chunkCount() const {
+    return chunks_.size();
+}
+
+FrameArena& FrameArena::local() {
+    thread_local FrameArena arena;
+    thread_local bool registered = false;
+    if (!registered) {
+        std::lock_guard<std::mutex> lock(registry_mutex);
+        registry.push_back(&arena);
+        registered = true;
+    }
+    return arena;
+}
+
+void FrameArena::resetAll() {
+    std::lock_guard<std::mutex> lock(registry_mutex);
+    for (FrameArena* arena : registry) {
+        arena->reset();
+    }
+}
+
+void* FrameArena::do_allocate(size_t bytes, size_t alignment) {
+    Chunk* chunk = &chunks_.back();
+    uintptr_t base = reinterpret_cast<uintptr_t>(chunk->data.get());
+    uintptr_t aligned = (base + offset_ + alignment - 1) & ~(static_cast<uintptr_t>(alignment) - 1);
+
+    if (aligned + bytes > base + chunk->size) {
+        // Overflow, the chunk is merged with the others on the next reset
+        addChunk(std::max(bytes + alignment, chunk->size * 2));
+        chunk = &chunks_.back();
+        base = reinterpret_cast<uintptr_t>(chunk->data.get());
+        aligned = (base + alignment - 1) & ~(static_cast<uintptr_t>(alignment) - 1);
+    }
+
+    offset_ = aligned + bytes - base;
+    used_ += bytes;
+    peak_ = std::max(peak_, used_);
+    return reinterpret_cast<void*>(aligned);
+}
+
+void FrameArena::do_deallocate(void* pointer, size_t bytes, size_t alignment) {
+    // Released in bulk by reset()
+}
+
+bool FrameArena::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+    return this == &other;
+}
+
+void FrameArena::addChunk(size_t size) {
+    Chunk chunk;
+    // Not value initialized, unlike make_unique
+    chunk.data.reset(new std::byte[size]);
+    chunk.size = size;
+    chunks_.push_back(std::move(chunk));
+    offset_ = 0;
+}
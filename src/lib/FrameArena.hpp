@@ -0,0 +1,54 @@
+// FrameArena.hpp
+
+#ifndef SRC_LIB_FRAMEARENA_HPP_
+#define SRC_LIB_FRAMEARENA_HPP_
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <vector>
+
+// Bump allocator for allocations that live until the end of the frame. Deallocation is a no-op,
+// reset() releases everything at once. When a frame overflows the arena it grows with extra
+// chunks, which the next reset() merges so steady state frames never touch the heap.
+class FrameArena : public std::pmr::memory_resource {
+ public:
+    static constexpr size_t DEFAULT_CAPACITY = 64 * 1024;
+
+    explicit FrameArena(size_t capacity = DEFAULT_CAPACITY);
+    ~FrameArena() override;
+
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    void reset();
+
+    size_t used() const;
+    size_t peak() const;
+    size_t capacity() const;
+    size_t chunkCount() const;
+
+    // Arena of the calling thread (main thread or flecs/job worker), created on first use
+    static FrameArena& local();
+    // Resets the arena of every thread, only call it at the end of the frame once workers are idle
+    static void resetAll();
+
+ private:
+    struct Chunk {
+        std::unique_ptr<std::byte[]> data;
+        size_t size = 0;
+    };
+
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void* pointer, size_t bytes, size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+    void addChunk(size_t size);
+
+    std::vector<Chunk> chunks_;
+    size_t offset_ = 0;  // In the last chunk
+    size_t used_ = 0;
+    size_t peak_ = 0;
+};
+
+#endif  // SRC_LIB_FRAMEARENA_HPP_
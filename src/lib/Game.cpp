@@ -0,0 +1,101 @@
+// Game.cpp
+
+#include "Game.hpp"
+
+#include <algorithm>
+#include <iostream>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "Hash.hpp"
+#include "WorldSnapshot.hpp"
+
+GameState createGame(world* ecs, Renderer* renderer) {
+    ecs->component<Render>();
+    ecs->component<Animation>();
+
+    const auto& sprite_map = renderer->getSpriteMap();
+    ecs->entity()
+        .set<Render>(
+            {
+                .z_index = 1,
+                .position = { static_cast<float>(SCREEN_WIDTH)/3, static_cast<float>(SCREEN_HEIGHT)/3 },
+                .sprite = sprite_map.at("attack/thief_0001")
+            }
+        )
+        .set<Animation>({ .name = "job1/m_bald_0001", .actual_frame = 1, .total_frames = 8, .current_frame = 0.0f });
+
+    ecs->entity()
+        .set<Render>(
+            {
+                .z_index = 2,
+                .position = { static_cast<float>(SCREEN_WIDTH)/3 + 5, static_cast<float>(SCREEN_HEIGHT)/3 + 5 },
+                .sprite = sprite_map.at("attack/thief_0001")
+            }
+        )
+        .set<Animation>({ .name = "job1/w_blonde_0001", .actual_frame = 1, .total_frames = 8, .current_frame = 0.0f });
+
+    renderer->setView({0.0f, 0.0f, static_cast<float>(SCREEN_WIDTH), static_cast<float>(SCREEN_HEIGHT)});
+
+    GameState state;
+    state.ball_position = { static_cast<float>(SCREEN_WIDTH)/2, static_cast<float>(SCREEN_HEIGHT)/2 };
+    return state;
+}
+
+void updateGame(GameState* state, const FrameInput& input) {
+    if (input.keys & INPUT_RIGHT) state->ball_position.x += BALL_SPEED;
+    if (input.keys & INPUT_LEFT) state->ball_position.x -= BALL_SPEED;
+    if (input.keys & INPUT_UP) state->ball_position.y -= BALL_SPEED;
+    if (input.keys & INPUT_DOWN) state->ball_position.y += BALL_SPEED;
+}
+
+void applyCheckpointInput(const FrameInput& input, const std::string& path, GameState* state, world* ecs) {
+    static_assert(std::is_trivially_copyable_v<GameState>, "GameState is checkpointed as raw bytes");
+    std::span<uint8_t> bytes(reinterpret_cast<uint8_t*>(state), sizeof(GameState));
+    std::string error;
+    if ((input.keys & INPUT_SAVE_CHECKPOINT) &&
+        !WorldSnapshot::save(path, ecs, nullptr, nullptr, bytes, &error)) {
+        std::cerr << error << std::endl;
+    }
+    if ((input.keys & INPUT_LOAD_CHECKPOINT) &&
+        !WorldSnapshot::load(path, ecs, nullptr, nullptr, bytes, &error)) {
+        std::cerr << error << std::endl;
+    }
+}
+
+uint64_t hashGame(const GameState& state, world* ecs) {
+    struct Entry {
+        uint64_t id;
+        const Render* render;
+        const Animation* animation;
+    };
+    std::vector<Entry> entries;
+    ecs->each([&entries](flecs::entity entity, const Render& render, const Animation& animation) {
+        entries.push_back({entity.id(), &render, &animation});
+    });
+    std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) { return a.id < b.id; });
+
+    uint64_t hash = FNV_OFFSET;
+    hashValue(&hash, state.ball_position.x);
+    hashValue(&hash, state.ball_position.y);
+    for (const Entry& entry : entries) {
+        const Render& render = *entry.render;
+        const Animation& animation = *entry.animation;
+        hashValue(&hash, render.z_index);
+        hashValue(&hash, render.position.x);
+        hashValue(&hash, render.position.y);
+        hashValue(&hash, render.sprite.location);
+        hashValue(&hash, render.sprite.x);
+        hashValue(&hash, render.sprite.y);
+        hashValue(&hash, render.sprite.width);
+        hashValue(&hash, render.sprite.height);
+        hashBytes(&hash, animation.name.data(), animation.name.size());
+        hashValue(&hash, animation.actual_frame);
+        hashValue(&hash, animation.total_frames);
+        hashValue(&hash, animation.current_frame);
+        hashValue(&hash, animation.synced_at);
+    }
+    return hash;
+}
@@ -0,0 +1,38 @@
+// Game.hpp
+
+#ifndef SRC_LIB_GAME_HPP_
+#define SRC_LIB_GAME_HPP_
+
+#include <cstdint>
+#include <string>
+
+#include "../interfaces/IInputSource.hpp"
+#include "Renderer.hpp"
+
+constexpr int SCREEN_WIDTH = 800;
+constexpr int SCREEN_HEIGHT = 450;
+constexpr float BALL_SPEED = 5.0f;   // Pixels per frame
+constexpr float BALL_RADIUS = 50.0f;
+constexpr const char* CHECKPOINT_PATH = "checkpoint.nmws";
+
+// State of the demo scene that lives outside of the ECS world
+struct GameState {
+    Vector2 ball_position{};
+};
+
+// Registers the components and spawns the demo characters
+GameState createGame(world* ecs, Renderer* renderer);
+
+// Applies the input of one frame, the ECS world is advanced separately with input.delta_time
+void updateGame(GameState* state, const FrameInput& input);
+
+// Saves or restores the entities and `state` to `path` on the checkpoint keys. Call it between frames,
+// while no job reads the world. Derived structures like the spatial index are not saved, they are
+// rebuilt from the restored entities.
+void applyCheckpointInput(const FrameInput& input, const std::string& path, GameState* state, world* ecs);
+
+// FNV-1a over the ball and every entity with Render and Animation, in entity id order so the hash
+// does not depend on the worker count
+uint64_t hashGame(const GameState& state, world* ecs);
+
+#endif  // SRC_LIB_GAME_HPP_
@@ -0,0 +1,26 @@
+// Hash.hpp
+
+#ifndef SRC_LIB_HASH_HPP_
+#define SRC_LIB_HASH_HPP_
+
+#include <cstddef>
+#include <cstdint>
+
+// 64 bit FNV-1a, used for draw list and world state hashes
+constexpr uint64_t FNV_OFFSET = 14695981039346656037ull;
+constexpr uint64_t FNV_PRIME = 1099511628211ull;
+
+inline void hashBytes(uint64_t* hash, const void* data, size_t size) {
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < size; ++i) {
+        *hash = (*hash ^ bytes[i]) * FNV_PRIME;
+    }
+}
+
+// Only for types without padding, hash padded structs field by field
+template <typename T>
+inline void hashValue(uint64_t* hash, const T& value) {
+    hashBytes(hash, &value, sizeof(value));
+}
+
+#endif  // SRC_LIB_HASH_HPP_
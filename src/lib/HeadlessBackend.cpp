@@ -0,0 +1,166 @@
+// HeadlessBackend.cpp
+
+#include "HeadlessBackend.hpp"
+#include "Hash.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+Texture2D HeadlessBackend::loadTexture(const std::string& path) {
+    // Reusing the lowest free id keeps the draw lists, and their hashes, stable across reloads
+    size_t slot = 0;
+    while (slot < textures_.size() && textures_[slot].id != 0) {
+        ++slot;
+    }
+    if (slot == textures_.size()) {
+        textures_.emplace_back();
+        texture_paths_.emplace_back();
+    }
+
+    Texture2D texture{};
+    texture.id = static_cast<unsigned>(slot + 1);
+    textures_[slot] = texture;
+    texture_paths_[slot] = path;
+    return texture;
+}
+
+void HeadlessBackend::unloadTexture(Texture2D texture) {
+    if (texture.id == 0 || texture.id > textures_.size()) return;
+
+    textures_[texture.id - 1] = Texture2D{};
+    texture_paths_[texture.id - 1].clear();
+}
+
+void HeadlessBackend::beginFrame() {
+    commands_.clear();
+    text_pool_.clear();
+}
+
+void HeadlessBackend::endFrame() {
+    frames_++;
+}
+
+void HeadlessBackend::clear(Color color) {
+    DrawCommand command;
+    command.op = DrawOp::CLEAR;
+    command.color = color;
+    commands_.push_back(command);
+}
+
+void HeadlessBackend::drawTexture(Texture2D texture, Rectangle source, Rectangle dest,
+                                  Vector2 origin, float rotation, Color tint) {
+    DrawCommand command;
+    command.op = DrawOp::TEXTURE;
+    command.color = tint;
+    command.resource = texture.id;
+    command.source = source;
+    command.dest = dest;
+    command.origin = origin;
+    command.rotation = rotation;
+    commands_.push_back(command);
+}
+
+void HeadlessBackend::drawText(const char* text, int x, int y, int font_size, Color color) {
+    DrawCommand command;
+    command.op = DrawOp::TEXT;
+    command.color = color;
+    command.resource = static_cast<uint32_t>(text_pool_.size());
+    command.length = static_cast<uint32_t>(std::strlen(text));
+    command.dest = {static_cast<float>(x), static_cast<float>(y), 0.0f, static_cast<float>(font_size)};
+
+    // Keep the terminator so replayed text can be handed to C APIs directly
+    text_pool_.append(text, command.length);
+    text_pool_.push_back('\0');
+    commands_.push_back(command);
+}
+
+void HeadlessBackend::drawCircle(Vector2 center, float radius, Color color) {
+    DrawCommand command;
+    command.op = DrawOp::CIRCLE;
+    command.color = color;
+    command.dest = {center.x, center.y, radius, 0.0f};
+    commands_.push_back(command);
+}
+
+const std::vector<DrawCommand>& HeadlessBackend::commands() const {
+    return commands_;
+}
+
+std::string_view HeadlessBackend::text(const DrawCommand& command) const {
+    if (command.op != DrawOp::TEXT) return {};
+    return std::string_view(text_pool_.data() + command.resource, command.length);
+}
+
+unsigned HeadlessBackend::framesRecorded() const {
+    return frames_;
+}
+
+uint64_t HeadlessBackend::frameHash() const {
+    uint64_t hash = FNV_OFFSET;
+    // Field by field, the padding inside DrawCommand is not deterministic
+    for (const auto& command : commands_) {
+        hashValue(&hash, command.op);
+        hashValue(&hash, command.color.r);
+        hashValue(&hash, command.color.g);
+        hashValue(&hash, command.color.b);
+        hashValue(&hash, command.color.a);
+        hashValue(&hash, command.source);
+        hashValue(&hash, command.dest);
+        hashValue(&hash, command.origin);
+        hashValue(&hash, command.rotation);
+        if (command.op == DrawOp::TEXT) {
+            std::string_view content = text(command);
+            hashBytes(&hash, content.data(), content.size());
+        } else {
+            hashValue(&hash, command.resource);
+        }
+    }
+    return hash;
+}
+
+size_t HeadlessBackend::loadedTextures() const {
+    return static_cast<size_t>(std::count_if(textures_.begin(), textures_.end(),
+                                             [](const Texture2D& texture) { return texture.id != 0; }));
+}
+
+std::string_view HeadlessBackend::texturePath(uint32_t id) const {
+    if (id == 0 || id > texture_paths_.size()) return {};
+    return texture_paths_[id - 1];
+}
+
+void HeadlessBackend::replay(IRenderBackend* target) const {
+    replay(target, textures_);
+}
+
+void HeadlessBackend::replay(IRenderBackend* target, const std::vector<Texture2D>& textures) const {
+    target->beginFrame();
+    for (const auto& command : commands_) {
+        switch (command.op) {
+            case DrawOp::CLEAR:
+                target->clear(command.color);
+                break;
+            case DrawOp::TEXTURE:
+                target->drawTexture(texture(command.resource, textures), command.source, command.dest,
+                                    command.origin, command.rotation, command.color);
+                break;
+            case DrawOp::TEXT:
+                target->drawText(text_pool_.data() + command.resource,
+                                 static_cast<int>(command.dest.x), static_cast<int>(command.dest.y),
+                                 static_cast<int>(command.dest.height), command.color);
+                break;
+            case DrawOp::CIRCLE:
+                target->drawCircle({command.dest.x, command.dest.y}, command.dest.width, command.color);
+                break;
+        }
+    }
+    target->endFrame();
+}
+
+Texture2D HeadlessBackend::texture(uint32_t id, const std::vector<Texture2D>& textures) const {
+    if (id >= 1 && id <= textures.size() && textures[id - 1].id != 0) {
+        return textures[id - 1];
+    }
+    Texture2D unknown{};
+    unknown.id = id;
+    return unknown;
+}
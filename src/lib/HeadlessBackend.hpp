@@ -0,0 +1,74 @@
+// HeadlessBackend.hpp
+
+#ifndef SRC_LIB_HEADLESSBACKEND_HPP_
+#define SRC_LIB_HEADLESSBACKEND_HPP_
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../interfaces/IRenderBackend.hpp"
+
+enum class DrawOp : uint8_t {
+    CLEAR,
+    TEXTURE,
+    TEXT,
+    CIRCLE
+};
+
+struct DrawCommand {
+    DrawOp op = DrawOp::CLEAR;
+    Color color{};
+    uint32_t resource = 0;  // Texture id, or offset in the text pool for TEXT
+    uint32_t length = 0;    // Text length
+    Rectangle source{};
+    Rectangle dest{};       // CIRCLE: x, y center and width radius, TEXT: x, y and height font size
+    Vector2 origin{};
+    float rotation = 0.0f;
+};
+
+// Records the draw calls of the current frame instead of sending them to a GPU. Textures are never
+// read from disk, they get ids starting at 1 and an unloaded texture frees its id for the next load.
+class HeadlessBackend : public IRenderBackend {
+ public:
+    Texture2D loadTexture(const std::string& path) override;
+    void unloadTexture(Texture2D texture) override;
+
+    // Starts a new command buffer, the capacity of the previous frame is kept
+    void beginFrame() override;
+    void endFrame() override;
+
+    void clear(Color color) override;
+    void drawTexture(Texture2D texture, Rectangle source, Rectangle dest,
+                     Vector2 origin, float rotation, Color tint) override;
+    void drawText(const char* text, int x, int y, int font_size, Color color) override;
+    void drawCircle(Vector2 center, float radius, Color color) override;
+
+    const std::vector<DrawCommand>& commands() const;
+    std::string_view text(const DrawCommand& command) const;
+    unsigned framesRecorded() const;
+
+    // Textures currently loaded, and the path a loaded id came from (empty when not loaded)
+    size_t loadedTextures() const;
+    std::string_view texturePath(uint32_t id) const;
+
+    // FNV-1a over the recorded commands, equal draw lists give equal hashes
+    uint64_t frameHash() const;
+
+    // Sends the recorded frame to another backend. Texture ids are looked up in `textures`
+    // (id 1 is textures[0]) so the frame can be replayed with textures loaded by the target.
+    void replay(IRenderBackend* target) const;
+    void replay(IRenderBackend* target, const std::vector<Texture2D>& textures) const;
+
+ private:
+    Texture2D texture(uint32_t id, const std::vector<Texture2D>& textures) const;
+
+    std::vector<DrawCommand> commands_;
+    std::string text_pool_;
+    std::vector<Texture2D> textures_;        // Slot id - 1, unloaded slots have id 0
+    std::vector<std::string> texture_paths_;
+    unsigned frames_ = 0;
+};
+
+#endif  // SRC_LIB_HEADLESSBACKEND_HPP_
@@ -0,0 +1,223 @@
+// InputLog.cpp
+
+#include "InputLog.hpp"
+
+#include <cstring>
+#include <iterator>
+#include <string>
+
+static const char INPUT_LOG_MAGIC[4] = {'N', 'M', 'I', 'L'};
+static const uint8_t RECORD_KEYS = 0x01;
+static const uint8_t RECORD_HASH = 0x02;
+// Runs and frame numbers are stored as varints, a sane log never needs more than 5 bytes
+static const unsigned MAX_VARINT_BYTES = 5;
+// Magic, version and step come before the frame count
+static const std::streamoff FRAME_COUNT_OFFSET = 12;
+
+static void writeUnsigned(std::ofstream& file, uint64_t value, unsigned bytes) {
+    for (unsigned i = 0; i < bytes; ++i) {
+        file.put(static_cast<char>((value >> (8 * i)) & 0xFF));
+    }
+}
+
+static void writeVarint(std::ofstream& file, uint32_t value) {
+    while (value >= 0x80) {
+        file.put(static_cast<char>((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    file.put(static_cast<char>(value));
+}
+
+// Bounds checked reader over the loaded file
+class LogReader {
+ public:
+    explicit LogReader(const std::vector<uint8_t>& data) : data_(data) {}
+
+    bool done() const { return position_ >= data_.size(); }
+
+    bool readUnsigned(uint64_t* value, unsigned bytes) {
+        if (data_.size() - position_ < bytes) return false;
+        *value = 0;
+        for (unsigned i = 0; i < bytes; ++i) {
+            *value |= static_cast<uint64_t>(data_[position_++]) << (8 * i);
+        }
+        return true;
+    }
+
+    bool readVarint(uint32_t* value) {
+        *value = 0;
+        for (unsigned i = 0; i < MAX_VARINT_BYTES && !done(); ++i) {
+            uint8_t byte = data_[position_++];
+            *value |= static_cast<uint32_t>(byte & 0x7F) << (7 * i);
+            if ((byte & 0x80) == 0) return true;
+        }
+        return false;
+    }
+
+ private:
+    const std::vector<uint8_t>& data_;
+    size_t position_ = 0;
+};
+
+InputRecorder::InputRecorder(IInputSource* source, const std::string& path, float step)
+    : source_(source), file_(path, std::ios::binary) {
+    uint32_t step_bits;
+    std::memcpy(&step_bits, &step, sizeof(step_bits));
+
+    file_.write(INPUT_LOG_MAGIC, sizeof(INPUT_LOG_MAGIC));
+    writeUnsigned(file_, INPUT_LOG_VERSION, 4);
+    writeUnsigned(file_, step_bits, 4);
+    writeUnsigned(file_, 0, 4);
+}
+
+InputRecorder::~InputRecorder() {
+    flushRun();
+}
+
+bool InputRecorder::poll(FrameInput* input) {
+    if (!source_->poll(input)) {
+        return false;
+    }
+
+    if (run_length_ > 0 && input->keys != run_keys_) {
+        flushRun();
+    }
+    run_keys_ = input->keys;
+    run_length_++;
+    frames_++;
+    return true;
+}
+
+void InputRecorder::checkpoint(uint64_t hash) {
+    if (frames_ == 0) return;
+
+    file_.put(static_cast<char>(RECORD_HASH));
+    writeVarint(file_, frames_ - 1);
+    writeUnsigned(file_, hash, 8);
+}
+
+bool InputRecorder::good() const {
+    return file_.good();
+}
+
+unsigned InputRecorder::frames() const {
+    return frames_;
+}
+
+void InputRecorder::flushRun() {
+    if (run_length_ == 0) return;
+
+    file_.put(static_cast<char>(RECORD_KEYS));
+    file_.put(static_cast<char>(run_keys_));
+    writeVarint(file_, run_length_);
+    run_length_ = 0;
+
+    // Every polled frame before the current one is in a run now, a crash still leaves a valid header
+    file_.seekp(FRAME_COUNT_OFFSET);
+    writeUnsigned(file_, frames_, 4);
+    file_.seekp(0, std::ios::end);
+    file_.flush();
+}
+
+bool InputReplay::load(const std::string& path, std::string* error) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        *error = "Could not open input log: " + path;
+        return false;
+    }
+    std::vector<uint8_t> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    if (data.size() < sizeof(INPUT_LOG_MAGIC) || std::memcmp(data.data(), INPUT_LOG_MAGIC, 4) != 0) {
+        *error = "Not an input log: " + path;
+        return false;
+    }
+
+    std::vector<uint8_t> body(data.begin() + sizeof(INPUT_LOG_MAGIC), data.end());
+    LogReader reader(body);
+    uint64_t version = 0;
+    uint64_t step_bits = 0;
+    uint64_t frame_count = 0;
+    if (!reader.readUnsigned(&version, 4)) {
+        *error = "Truncated input log header: " + path;
+        return false;
+    }
+    if (version != INPUT_LOG_VERSION) {
+        *error = "Unsupported input log version " + std::to_string(version) + ": " + path;
+        return false;
+    }
+    if (!reader.readUnsigned(&step_bits, 4) || !reader.readUnsigned(&frame_count, 4)) {
+        *error = "Truncated input log header: " + path;
+        return false;
+    }
+    uint32_t step_value = static_cast<uint32_t>(step_bits);
+    std::memcpy(&step_, &step_value, sizeof(step_));
+
+    keys_.clear();
+    checkpoints_.clear();
+    next_ = 0;
+    while (!reader.done()) {
+        uint64_t type = 0;
+        reader.readUnsigned(&type, 1);
+
+        if (type == RECORD_KEYS) {
+            uint64_t keys = 0;
+            uint32_t run = 0;
+            if (!reader.readUnsigned(&keys, 1) || !reader.readVarint(&run)) {
+                *error = "Truncated input log: " + path;
+                return false;
+            }
+            // The run length comes from the file, never trust it beyond the frame count
+            if (run > frame_count - keys_.size()) {
+                *error = "Corrupted input log, more frames than the header announces: " + path;
+                return false;
+            }
+            keys_.insert(keys_.end(), run, static_cast<uint8_t>(keys));
+        } else if (type == RECORD_HASH) {
+            uint32_t frame = 0;
+            uint64_t hash = 0;
+            if (!reader.readVarint(&frame) || !reader.readUnsigned(&hash, 8)) {
+                *error = "Truncated input log: " + path;
+                return false;
+            }
+            checkpoints_[frame] = hash;
+        } else {
+            *error = "Corrupted input log: " + path;
+            return false;
+        }
+    }
+
+    // The header is patched after every written run, fewer frames means the runs were cut off
+    if (keys_.size() != frame_count) {
+        *error = "Truncated input log: " + path;
+        return false;
+    }
+    return true;
+}
+
+bool InputReplay::poll(FrameInput* input) {
+    if (next_ >= keys_.size()) {
+        return false;
+    }
+    input->keys = keys_[next_++];
+    input->delta_time = step_;
+    return true;
+}
+
+bool InputReplay::checkpoint(unsigned frame, uint64_t* hash) const {
+    auto found = checkpoints_.find(frame);
+    if (found == checkpoints_.end()) return false;
+    *hash = found->second;
+    return true;
+}
+
+float InputReplay::step() const {
+    return step_;
+}
+
+size_t InputReplay::frameCount() const {
+    return keys_.size();
+}
+
+size_t InputReplay::checkpointCount() const {
+    return checkpoints_.size();
+}
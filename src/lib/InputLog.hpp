@@ -0,0 +1,69 @@
+// InputLog.hpp
+
+#ifndef SRC_LIB_INPUTLOG_HPP_
+#define SRC_LIB_INPUTLOG_HPP_
+
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "../interfaces/IInputSource.hpp"
+
+// Binary input log, little endian:
+//   header   "NMIL", u32 version, f32 fixed step, u32 frame count (updated after every run)
+//   0x01     u8 keys, varint frames    keys held for a run of frames
+//   0x02     varint frame, u64 hash    world hash after that frame (0 based)
+constexpr uint32_t INPUT_LOG_VERSION = 2;
+
+// Passes the frames of another source through and writes their keys to a log. The source must use
+// the fixed step given here, the replay advances every frame by it.
+class InputRecorder : public IInputSource {
+ public:
+    InputRecorder(IInputSource* source, const std::string& path, float step);
+    ~InputRecorder() override;
+
+    InputRecorder(const InputRecorder&) = delete;
+    InputRecorder& operator=(const InputRecorder&) = delete;
+
+    bool poll(FrameInput* input) override;
+
+    // Records the world hash after the last polled frame
+    void checkpoint(uint64_t hash);
+
+    bool good() const;
+    unsigned frames() const;
+
+ private:
+    void flushRun();
+
+    IInputSource* source_;
+    std::ofstream file_;
+    uint8_t run_keys_ = 0;
+    uint32_t run_length_ = 0;
+    unsigned frames_ = 0;
+};
+
+// Plays a log back at full speed, every frame advances by the recorded fixed step
+class InputReplay : public IInputSource {
+ public:
+    bool load(const std::string& path, std::string* error);
+
+    bool poll(FrameInput* input) override;
+
+    // Hash recorded after `frame`, false when that frame has no checkpoint
+    bool checkpoint(unsigned frame, uint64_t* hash) const;
+
+    float step() const;
+    size_t frameCount() const;
+    size_t checkpointCount() const;
+
+ private:
+    std::vector<uint8_t> keys_;
+    std::map<unsigned, uint64_t> checkpoints_;
+    float step_ = 0.0f;
+    size_t next_ = 0;
+};
+
+#endif  // SRC_LIB_INPUTLOG_HPP_
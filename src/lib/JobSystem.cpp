@@ -0,0 +1,298 @@
+// JobSystem.cpp
+
+#include "JobSystem.hpp"
+
+#include <algorithm>
+#include <new>
+#include <utility>
+
+// Queue owned by the current thread, only meaningful when tls_owner matches the job system
+static thread_local const JobSystem* tls_owner = nullptr;
+static thread_local unsigned tls_index = 0;
+
+// Blocks of the Job allocations, recycled instead of returned to the heap so steady state jobs do
+// not allocate themselves. Work that does not fit the small buffer of std::function still does.
+// Never destroyed, handles may outlive every JobSystem.
+struct JobPool {
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    std::mutex mutex;
+    size_t block_size = 0;  // Size of the first allocation, every Job allocation has the same
+    FreeBlock* free = nullptr;
+};
+
+static JobPool& jobPool() {
+    static JobPool* pool = new JobPool();
+    return *pool;
+}
+
+static void* allocateJobBlock(size_t bytes) {
+    JobPool& pool = jobPool();
+    {
+        std::lock_guard<std::mutex> lock(pool.mutex);
+        if (pool.block_size == 0) {
+            pool.block_size = bytes;
+        }
+        if (bytes == pool.block_size && pool.free != nullptr) {
+            JobPool::FreeBlock* block = pool.free;
+            pool.free = block->next;
+            return block;
+        }
+    }
+    return ::operator new(std::max(bytes, sizeof(JobPool::FreeBlock)));
+}
+
+static void freeJobBlock(void* pointer, size_t bytes) {
+    JobPool& pool = jobPool();
+    std::lock_guard<std::mutex> lock(pool.mutex);
+    if (bytes != pool.block_size) {
+        ::operator delete(pointer);
+        return;
+    }
+    auto* block = static_cast<JobPool::FreeBlock*>(pointer);
+    block->next = pool.free;
+    pool.free = block;
+}
+
+// Routes the single allocation of allocate_shared<Job> (control block and Job) through the pool
+template <typename T>
+struct JobAllocator {
+    using value_type = T;
+
+    JobAllocator() noexcept = default;
+    template <typename U>
+    JobAllocator(const JobAllocator<U>&) noexcept {}  // NOLINT(runtime/explicit)
+
+    T* allocate(size_t count) { return static_cast<T*>(allocateJobBlock(count * sizeof(T))); }
+    void deallocate(T* pointer, size_t count) noexcept { freeJobBlock(pointer, count * sizeof(T)); }
+
+    template <typename U>
+    bool operator==(const JobAllocator<U>&) const noexcept { return true; }
+};
+
+JobSystem::JobSystem(unsigned workers) {
+    if (workers == 0) {
+        unsigned hardware = std::thread::hardware_concurrency();
+        workers = hardware > 1 ? hardware - 1 : 1;
+    }
+
+    // One deque per worker plus a shared one for jobs submitted from outside the pool
+    for (unsigned i = 0; i <= workers; ++i) {
+        queues_.push_back(std::make_unique<Queue>());
+    }
+
+    threads_.reserve(workers);
+    for (unsigned i = 0; i < workers; ++i) {
+        threads_.emplace_back(&JobSystem::workerLoop, this, i);
+    }
+}
+
+JobSystem::~JobSystem() {
+    {
+        std::lock_guard<std::mutex> lock(sleep_mutex_);
+        stopping_ = true;
+    }
+    wake_.notify_all();
+
+    for (auto& thread : threads_) {
+        thread.join();
+    }
+}
+
+JobHandle JobSystem::submit(std::function<void()> work, std::initializer_list<JobHandle> dependencies) {
+    return submit(std::move(work), std::span<const JobHandle>(dependencies.begin(), dependencies.size()));
+}
+
+JobHandle JobSystem::submit(std::function<void()> work, std::span<const JobHandle> dependencies) {
+    auto job = std::allocate_shared<Job>(JobAllocator<Job>());
+    job->work = std::move(work);
+
+    for (const auto& dependency : dependencies) {
+        if (!dependency.job_) continue;
+
+        std::lock_guard<std::mutex> lock(dependency.job_->mutex);
+        if (!dependency.job_->finished.load(std::memory_order_acquire)) {
+            dependency.job_->dependents.push_back(job);
+            job->pending.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    // Drop the submission guard, the last finished dependency schedules the job otherwise
+    if (job->pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        schedule(job);
+    }
+
+    return JobHandle(job);
+}
+
+void JobSystem::wait(const JobHandle& handle) {
+    runUntilDone(handle);
+
+    if (handle.job_ && handle.job_->error) {
+        std::rethrow_exception(handle.job_->error);
+    }
+}
+
+void JobSystem::wait(const std::vector<JobHandle>& handles) {
+    std::exception_ptr error;
+    for (const auto& handle : handles) {
+        runUntilDone(handle);
+        if (!error && handle.job_ && handle.job_->error) {
+            error = handle.job_->error;
+        }
+    }
+
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+void JobSystem::parallelFor(size_t begin, size_t end, size_t grain,
+                            const std::function<void(size_t, size_t)>& body) {
+    if (begin >= end) return;
+    grain = std::max<size_t>(grain, 1);
+
+    // Chunks have no handles, the group counts them down and keeps the first exception
+    RangeGroup group;
+    group.remaining.store((end - begin + grain - 1) / grain, std::memory_order_relaxed);
+    for (size_t first = begin; first < end; first += grain) {
+        auto job = std::allocate_shared<Job>(JobAllocator<Job>());
+        job->range = &body;
+        job->first = first;
+        job->last = std::min(first + grain, end);
+        job->group = &group;
+        schedule(std::move(job));
+    }
+
+    while (group.remaining.load(std::memory_order_acquire) > 0) {
+        if (!runOne()) {
+            std::this_thread::yield();
+        }
+    }
+
+    if (group.error) {
+        std::rethrow_exception(group.error);
+    }
+}
+
+unsigned JobSystem::workerCount() const {
+    return static_cast<unsigned>(threads_.size());
+}
+
+void JobSystem::runUntilDone(const JobHandle& handle) {
+    while (!handle.done()) {
+        if (!runOne()) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+void JobSystem::workerLoop(unsigned index) {
+    tls_owner = this;
+    tls_index = index;
+
+    while (true) {
+        if (runOne()) continue;
+
+        std::unique_lock<std::mutex> lock(sleep_mutex_);
+        wake_.wait(lock, [this]() { return stopping_ || queued_.load(std::memory_order_acquire) > 0; });
+        if (stopping_ && queued_.load(std::memory_order_acquire) == 0) {
+            return;
+        }
+    }
+}
+
+void JobSystem::schedule(std::shared_ptr<Job> job) {
+    Queue& queue = *queues_[currentQueue()];
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.jobs.push_back(std::move(job));
+    }
+    queued_.fetch_add(1, std::memory_order_release);
+
+    // Taking the lock orders the increment with a worker checking the predicate before sleeping
+    { std::lock_guard<std::mutex> lock(sleep_mutex_); }
+    wake_.notify_one();
+}
+
+void JobSystem::complete(const std::shared_ptr<Job>& job) {
+    try {
+        if (job->range != nullptr) {
+            (*job->range)(job->first, job->last);
+        } else {
+            job->work();
+        }
+    } catch (...) {
+        job->error = std::current_exception();
+    }
+    job->work = nullptr;
+
+    if (job->group != nullptr) {
+        if (job->error) {
+            std::lock_guard<std::mutex> lock(job->group->mutex);
+            if (!job->group->error) {
+                job->group->error = job->error;
+            }
+        }
+        // Last access to the group, parallelFor returns as soon as it reaches zero
+        job->group->remaining.fetch_sub(1, std::memory_order_release);
+    }
+
+    std::vector<std::shared_ptr<Job>> dependents;
+    {
+        std::lock_guard<std::mutex> lock(job->mutex);
+        job->finished.store(true, std::memory_order_release);
+        dependents.swap(job->dependents);
+    }
+
+    for (auto& dependent : dependents) {
+        if (dependent->pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            schedule(std::move(dependent));
+        }
+    }
+}
+
+bool JobSystem::runOne() {
+    unsigned index = currentQueue();
+    std::shared_ptr<Job> job = pop(index);
+    if (!job) {
+        job = steal(index);
+    }
+    if (!job) return false;
+
+    queued_.fetch_sub(1, std::memory_order_acq_rel);
+    complete(job);
+    return true;
+}
+
+std::shared_ptr<Job> JobSystem::pop(unsigned index) {
+    Queue& queue = *queues_[index];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.jobs.empty()) return nullptr;
+
+    std::shared_ptr<Job> job = std::move(queue.jobs.back());
+    queue.jobs.pop_back();
+    return job;
+}
+
+std::shared_ptr<Job> JobSystem::steal(unsigned thief) {
+    for (size_t offset = 1; offset < queues_.size(); ++offset) {
+        Queue& queue = *queues_[(thief + offset) % queues_.size()];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.jobs.empty()) continue;
+
+        std::shared_ptr<Job> job = std::move(queue.jobs.front());
+        queue.jobs.pop_front();
+        return job;
+    }
+    return nullptr;
+}
+
+unsigned JobSystem::currentQueue() {
+    if (tls_owner == this) {
+        return tls_index;
+    }
+    return static_cast<unsigned>(queues_.size() - 1);
+}
@@ -0,0 +1,109 @@
+// JobSystem.hpp
+
+#ifndef SRC_LIB_JOBSYSTEM_HPP_
+#define SRC_LIB_JOBSYSTEM_HPP_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <vector>
+
+// Completion counter of one JobSystem::parallelFor call, lives on the stack of the caller
+struct RangeGroup {
+    std::atomic<size_t> remaining{0};
+    std::mutex mutex;
+    std::exception_ptr error;  // Of the first failed chunk
+};
+
+struct Job {
+    std::function<void()> work;
+    // parallelFor chunks run (*range)(first, last) instead of `work`, a lambda capturing the body and
+    // the bounds would not fit the small buffer of std::function and allocate for every chunk
+    const std::function<void(size_t, size_t)>* range = nullptr;
+    size_t first = 0;
+    size_t last = 0;
+    RangeGroup* group = nullptr;
+    // Unfinished dependencies, plus one while the job is being submitted
+    std::atomic<unsigned> pending{1};
+    std::atomic<bool> finished{false};
+    std::exception_ptr error;
+
+    std::mutex mutex;
+    std::vector<std::shared_ptr<Job>> dependents;
+};
+
+// Completion handle of a submitted job, an empty handle counts as finished
+class JobHandle {
+ public:
+    JobHandle() = default;
+    explicit JobHandle(std::shared_ptr<Job> job) : job_(std::move(job)) {}
+
+    bool done() const { return !job_ || job_->finished.load(std::memory_order_acquire); }
+
+ private:
+    friend class JobSystem;
+    std::shared_ptr<Job> job_;
+};
+
+// Work-stealing scheduler: every worker owns a deque, pushes and pops at the back and steals from
+// the front of the other deques when its own runs dry. Jobs can depend on other jobs, they are only
+// queued once all their dependencies finished, which makes it possible to build task graphs.
+class JobSystem {
+ public:
+    // Starts `workers` threads, zero uses the hardware concurrency minus the calling thread
+    explicit JobSystem(unsigned workers = 0);
+    ~JobSystem();
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    JobHandle submit(std::function<void()> work, std::initializer_list<JobHandle> dependencies = {});
+    JobHandle submit(std::function<void()> work, std::span<const JobHandle> dependencies);
+
+    // Blocks until the job finished, running queued jobs meanwhile. Rethrows the job exception.
+    void wait(const JobHandle& handle);
+    // Blocks until every job finished, then rethrows the exception of the first failed one. Jobs
+    // are never left running on an unwinding caller, they may reference its stack.
+    void wait(const std::vector<JobHandle>& handles);
+
+    // Splits [begin, end) in chunks of at most `grain` items and runs them on the workers.
+    // Blocks until every chunk finished, the calling thread takes part in the work. The exception
+    // of a failed chunk is rethrown once all the others are done. Apart from a new block of a
+    // queue deque now and then, a call does not allocate once the job pool is warm.
+    void parallelFor(size_t begin, size_t end, size_t grain, const std::function<void(size_t, size_t)>& body);
+
+    unsigned workerCount() const;
+
+ private:
+    struct Queue {
+        std::mutex mutex;
+        std::deque<std::shared_ptr<Job>> jobs;
+    };
+
+    void workerLoop(unsigned index);
+    void runUntilDone(const JobHandle& handle);
+    void schedule(std::shared_ptr<Job> job);
+    void complete(const std::shared_ptr<Job>& job);
+    bool runOne();
+    std::shared_ptr<Job> pop(unsigned index);
+    std::shared_ptr<Job> steal(unsigned thief);
+    unsigned currentQueue();
+
+    std::vector<std::unique_ptr<Queue>> queues_;
+    std::vector<std::thread> threads_;
+
+    std::mutex sleep_mutex_;
+    std::condition_variable wake_;
+    std::atomic<size_t> queued_{0};
+    bool stopping_ = false;
+};
+
+#endif  // SRC_LIB_JOBSYSTEM_HPP_
@@ -0,0 +1,21 @@
+// LiveInput.cpp
+
+#include "LiveInput.hpp"
+
+#include "raylib.h"
+
+LiveInput::LiveInput(float fixed_step) : fixed_step_(fixed_step) {}
+
+bool LiveInput::poll(FrameInput* input) {
+    input->keys = 0;
+    if (IsKeyDown(KEY_RIGHT)) input->keys |= INPUT_RIGHT;
+    if (IsKeyDown(KEY_LEFT)) input->keys |= INPUT_LEFT;
+    if (IsKeyDown(KEY_UP)) input->keys |= INPUT_UP;
+    if (IsKeyDown(KEY_DOWN)) input->keys |= INPUT_DOWN;
+    if (IsKeyPressed(KEY_F3)) input->keys |= INPUT_TOGGLE_PROFILER;
+    if (IsKeyPressed(KEY_F5)) input->keys |= INPUT_SAVE_CHECKPOINT;
+    if (IsKeyPressed(KEY_F9)) input->keys |= INPUT_LOAD_CHECKPOINT;
+
+    input->delta_time = fixed_step_ > 0.0f ? fixed_step_ : GetFrameTime();
+    return true;
+}
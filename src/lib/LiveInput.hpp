@@ -0,0 +1,19 @@
+// LiveInput.hpp
+
+#ifndef SRC_LIB_LIVEINPUT_HPP_
+#define SRC_LIB_LIVEINPUT_HPP_
+
+#include "../interfaces/IInputSource.hpp"
+
+// Polls the keyboard through raylib. With a fixed step every frame advances by that step instead of
+// GetFrameTime(), which is what a recording needs to be replayed deterministically.
+class LiveInput : public IInputSource {
+ public:
+    explicit LiveInput(float fixed_step = 0.0f);
+    bool poll(FrameInput* input) override;
+
+ private:
+    float fixed_step_;
+};
+
+#endif  // SRC_LIB_LIVEINPUT_HPP_
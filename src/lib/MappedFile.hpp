@@ -0,0 +1,34 @@
+// MappedFile.hpp
+
+#ifndef SRC_LIB_MAPPEDFILE_HPP_
+#define SRC_LIB_MAPPEDFILE_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Read only mapping of a whole file, pages are loaded by the OS on first access
+class MappedFile {
+ public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool open(const std::string& path);
+    void close();
+
+    const uint8_t* data() const;
+    size_t size() const;
+
+ private:
+    const uint8_t* data_ = nullptr;
+    size_t size_ = 0;
+#ifdef _WIN32
+    void* file_ = nullptr;     // HANDLE, windows.h stays out of the header
+    void* mapping_ = nullptr;
+#endif
+};
+
+#endif  // SRC_LIB_MAPPEDFILE_HPP_
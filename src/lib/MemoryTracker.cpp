@@ -0,0 +1,234 @@
+// MemoryTracker.cpp
+
+#include "MemoryTracker.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstdio>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <limits>
+#include <utility>
+
+#include "flecs.h"
+
+static const size_t TAG_COUNT = static_cast<size_t>(MemoryTag::COUNT);
+static const double BYTES_PER_MIB = 1024.0 * 1024.0;
+// flecs frees without a size, every block carries it in front. Keeps the malloc alignment.
+static const size_t ECS_HEADER = 16;
+
+static const char* const TAG_NAMES[TAG_COUNT] = {
+    "pathfinding",
+    "spatial_index",
+    "sprite_map",
+    "textures",
+    "ecs"
+};
+
+struct TagCounters {
+    std::atomic<size_t> live{0};
+    std::atomic<size_t> peak{0};
+    std::atomic<uint64_t> allocations{0};
+    std::atomic<uint64_t> frees{0};
+    std::atomic<size_t> budget{0};
+    std::atomic<bool> warned{false};
+};
+
+static std::array<TagCounters, TAG_COUNT> counters;
+
+// stdio instead of iostreams, this also runs inside the flecs allocation hooks
+static void warnOnStderr(MemoryTag tag, size_t live_bytes, size_t budget_bytes) {
+    std::fprintf(stderr, "Memory budget exceeded: %s uses %.2f MiB, budget %.2f MiB\n",
+                 MemoryTracker::name(tag), live_bytes / BYTES_PER_MIB, budget_bytes / BYTES_PER_MIB);
+}
+
+static std::atomic<MemoryWarningSink> warning_sink{warnOnStderr};
+
+void MemoryTracker::allocated(MemoryTag tag, size_t bytes) {
+    TagCounters& tag_counters = counters[static_cast<size_t>(tag)];
+    tag_counters.allocations.fetch_add(1, std::memory_order_relaxed);
+    size_t live = tag_counters.live.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+
+    size_t peak = tag_counters.peak.load(std::memory_order_relaxed);
+    while (live > peak && !tag_counters.peak.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {}
+
+    size_t budget = tag_counters.budget.load(std::memory_order_relaxed);
+    if (budget != 0 && live > budget && !tag_counters.warned.exchange(true, std::memory_order_relaxed)) {
+        warning_sink.load(std::memory_order_relaxed)(tag, live, budget);
+    }
+}
+
+void MemoryTracker::freed(MemoryTag tag, size_t bytes) {
+    TagCounters& tag_counters = counters[static_cast<size_t>(tag)];
+    tag_counters.frees.fetch_add(1, std::memory_order_relaxed);
+    size_t live = tag_counters.live.fetch_sub(bytes, std::memory_order_relaxed) - bytes;
+
+    // Warn again the next time the budget is exceeded
+    if (live <= tag_counters.budget.load(std::memory_order_relaxed)) {
+        tag_counters.warned.store(false, std::memory_order_relaxed);
+    }
+}
+
+MemoryStats MemoryTracker::stats(MemoryTag tag) {
+    const TagCounters& tag_counters = counters[static_cast<size_t>(tag)];
+    MemoryStats stats;
+    stats.tag = tag;
+    stats.name = name(tag);
+    stats.live_bytes = tag_counters.live.load(std::memory_order_relaxed);
+    stats.peak_bytes = tag_counters.peak.load(std::memory_order_relaxed);
+    stats.allocations = tag_counters.allocations.load(std::memory_order_relaxed);
+    stats.frees = tag_counters.frees.load(std::memory_order_relaxed);
+    stats.budget_bytes = tag_counters.budget.load(std::memory_order_relaxed);
+    return stats;
+}
+
+std::vector<MemoryStats> MemoryTracker::report() {
+    std::vector<MemoryStats> report;
+    report.reserve(TAG_COUNT);
+    for (size_t i = 0; i < TAG_COUNT; ++i) {
+        report.push_back(stats(static_cast<MemoryTag>(i)));
+    }
+    return report;
+}
+
+void MemoryTracker::setBudget(MemoryTag tag, size_t bytes) {
+    TagCounters& tag_counters = counters[static_cast<size_t>(tag)];
+    tag_counters.budget.store(bytes, std::memory_order_relaxed);
+    tag_counters.warned.store(false, std::memory_order_relaxed);
+}
+
+bool MemoryTracker::overBudget(MemoryTag tag) {
+    MemoryStats current = stats(tag);
+    return current.budget_bytes != 0 && current.live_bytes > current.budget_bytes;
+}
+
+void MemoryTracker::setWarningSink(MemoryWarningSink sink) {
+    warning_sink.store(sink != nullptr ? sink : warnOnStderr, std::memory_order_relaxed);
+}
+
+const char* MemoryTracker::name(MemoryTag tag) {
+    size_t index = static_cast<size_t>(tag);
+    return index < TAG_COUNT ? TAG_NAMES[index] : "unknown";
+}
+
+bool applyMemoryBudgets(const char* budgets, std::string* error) {
+    if (budgets == nullptr) return true;
+
+    // Everything is validated before the first budget changes
+    std::vector<std::pair<MemoryTag, size_t>> parsed;
+    std::string text(budgets);
+    size_t start = 0;
+    while (start < text.size()) {
+        size_t end = text.find(',', start);
+        if (end == std::string::npos) end = text.size();
+        std::string entry = text.substr(start, end - start);
+        start = end + 1;
+
+        size_t equals = entry.find('=');
+        size_t tag = TAG_COUNT;
+        for (size_t i = 0; i < TAG_COUNT && equals != std::string::npos; ++i) {
+            if (entry.compare(0, equals, TAG_NAMES[i]) == 0) tag = i;
+        }
+        char* parsed_end = nullptr;
+        const char* value = equals != std::string::npos ? entry.c_str() + equals + 1 : "";
+        double mib = std::strtod(value, &parsed_end);
+        double bytes = mib * BYTES_PER_MIB;
+        // Not finite covers nan and inf, the size_t maximum rounds up to 2^64 as a double
+        if (tag == TAG_COUNT || parsed_end == value || *parsed_end != '\0' || !std::isfinite(bytes) ||
+            bytes < 0.0 || bytes >= static_cast<double>(std::numeric_limits<size_t>::max())) {
+            *error = "Invalid memory budget: " + entry;
+            return false;
+        }
+        parsed.emplace_back(static_cast<MemoryTag>(tag), static_cast<size_t>(bytes));
+    }
+
+    for (const auto& [tag, bytes] : parsed) {
+        MemoryTracker::setBudget(tag, bytes);
+    }
+    return true;
+}
+
+static void* ecsMalloc(ecs_size_t size) {
+    char* block = static_cast<char*>(std::malloc(ECS_HEADER + static_cast<size_t>(size)));
+    if (block == nullptr) return nullptr;
+    std::memcpy(block, &size, sizeof(size));
+    MemoryTracker::allocated(MemoryTag::ECS, static_cast<size_t>(size));
+    return block + ECS_HEADER;
+}
+
+static void* ecsCalloc(ecs_size_t size) {
+    char* block = static_cast<char*>(std::calloc(1, ECS_HEADER + static_cast<size_t>(size)));
+    if (block == nullptr) return nullptr;
+    std::memcpy(block, &size, sizeof(size));
+    MemoryTracker::allocated(MemoryTag::ECS, static_cast<size_t>(size));
+    return block + ECS_HEADER;
+}
+
+static void ecsFree(void* pointer) {
+    if (pointer == nullptr) return;
+    char* block = static_cast<char*>(pointer) - ECS_HEADER;
+    ecs_size_t size;
+    std::memcpy(&size, block, sizeof(size));
+    MemoryTracker::freed(MemoryTag::ECS, static_cast<size_t>(size));
+    std::free(block);
+}
+
+static void* ecsRealloc(void* pointer, ecs_size_t size) {
+    if (pointer == nullptr) return ecsMalloc(size);
+
+    char* block = static_cast<char*>(pointer) - ECS_HEADER;
+    ecs_size_t previous;
+    std::memcpy(&previous, block, sizeof(previous));
+    char* moved = static_cast<char*>(std::realloc(block, ECS_HEADER + static_cast<size_t>(size)));
+    if (moved == nullptr) return nullptr;
+
+    std::memcpy(moved, &size, sizeof(size));
+    MemoryTracker::freed(MemoryTag::ECS, static_cast<size_t>(previous));
+    MemoryTracker::allocated(MemoryTag::ECS, static_cast<size_t>(size));
+    return moved + ECS_HEADER;
+}
+
+bool installEcsMemoryHooks() {
+    static bool installed = false;
+    if (installed) return true;
+
+    // The defaults are only filled in once the OS API is initialized, by a world or by anyone else.
+    // Blocks allocated before would reach ecsFree without a size header.
+    if (ecs_os_api.malloc_ != nullptr) {
+        return false;
+    }
+    installed = true;
+
+    // Fills in the defaults and the threading functions, later calls by ecs_init keep this API
+    ecs_set_os_api_impl();
+    ecs_os_api.malloc_ = ecsMalloc;
+    ecs_os_api.calloc_ = ecsCalloc;
+    ecs_os_api.realloc_ = ecsRealloc;
+    ecs_os_api.free_ = ecsFree;
+    return true;
+}
+
+void printMemoryReport(std::ostream& out, const std::vector<MemoryStats>& report) {
+    std::ios_base::fmtflags flags = out.flags();
+    out << std::fixed << std::setprecision(2) << "Memory by subsystem (MiB):\n"
+        << "  " << std::left << std::setw(16) << "tag" << std::right
+        << std::setw(10) << "live" << std::setw(10) << "peak" << std::setw(14) << "allocations"
+        << std::setw(10) << "budget" << "\n";
+    for (const MemoryStats& stats : report) {
+        out << "  " << std::left << std::setw(16) << stats.name << std::right
+            << std::setw(10) << stats.live_bytes / BYTES_PER_MIB
+            << std::setw(10) << stats.peak_bytes / BYTES_PER_MIB
+            << std::setw(14) << stats.allocations;
+        if (stats.budget_bytes != 0) {
+            out << std::setw(10) << stats.budget_bytes / BYTES_PER_MIB
+                << (stats.live_bytes > stats.budget_bytes ? "  OVER BUDGET" : "");
+        } else {
+            out << std::setw(10) << "-";
+        }
+        out << "\n";
+    }
+    out.flush();
+    out.flags(flags);
+}
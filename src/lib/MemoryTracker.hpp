@@ -0,0 +1,97 @@
+// MemoryTracker.hpp
+
+#ifndef SRC_LIB_MEMORYTRACKER_HPP_
+#define SRC_LIB_MEMORYTRACKER_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// Environment variable with budgets in MiB per tag, e.g. "pathfinding=64,ecs=256"
+constexpr const char* MEMORY_BUDGET_ENV = "NODE_MAZE_MEMORY_BUDGETS";
+
+enum class MemoryTag : uint8_t {
+    PATHFINDING,    // FloydWarshal matrices and id mapping
+    SPATIAL_INDEX,  // QuadTree nodes and the SpatialIndex position snapshot
+    SPRITE_MAP,     // Renderer sprite map nodes and buckets
+    TEXTURES,       // GPU textures, estimated from their size and format
+    ECS,            // Every flecs allocation, see installEcsMemoryHooks()
+    COUNT
+};
+
+struct MemoryStats {
+    MemoryTag tag = MemoryTag::COUNT;
+    const char* name = "";
+    size_t live_bytes = 0;
+    size_t peak_bytes = 0;
+    uint64_t allocations = 0;
+    uint64_t frees = 0;
+    size_t budget_bytes = 0;  // Zero without a budget
+};
+
+// Receives budget warnings, called on the allocating thread (possibly inside a flecs allocation)
+using MemoryWarningSink = void (*)(MemoryTag tag, size_t live_bytes, size_t budget_bytes);
+
+// Live bytes, peak bytes and allocation counts per subsystem. Lock free, callable from any thread.
+class MemoryTracker {
+ public:
+    static void allocated(MemoryTag tag, size_t bytes);
+    static void freed(MemoryTag tag, size_t bytes);
+
+    static MemoryStats stats(MemoryTag tag);
+    static std::vector<MemoryStats> report();  // Every tag, in enum order
+
+    // Warns once each time the live bytes of `tag` go over `bytes`, zero removes the budget
+    static void setBudget(MemoryTag tag, size_t bytes);
+    static bool overBudget(MemoryTag tag);
+    // Replaces the default warning on stderr, nullptr restores it
+    static void setWarningSink(MemoryWarningSink sink);
+
+    static const char* name(MemoryTag tag);
+};
+
+// Applies budgets like "pathfinding=64,ecs=256" (MiB). Returns false with `error` and applies none of
+// them on malformed text, unknown tags or values that are negative, not finite or too large.
+bool applyMemoryBudgets(const char* budgets, std::string* error);
+
+// Routes the flecs allocations through the ECS tag by replacing the allocation functions of the flecs
+// OS API. Returns false and changes nothing once that API is initialized, e.g. by a world, since
+// flecs may already hold blocks from the default allocator. Returns true when the hooks are in place.
+bool installEcsMemoryHooks();
+
+void printMemoryReport(std::ostream& out, const std::vector<MemoryStats>& report);
+
+// Standard allocator that accounts its memory to `Tag`
+template <typename T, MemoryTag Tag>
+class TrackedAllocator {
+ public:
+    using value_type = T;
+
+    template <typename U>
+    struct rebind {
+        using other = TrackedAllocator<U, Tag>;
+    };
+
+    TrackedAllocator() noexcept = default;
+    template <typename U>
+    TrackedAllocator(const TrackedAllocator<U, Tag>&) noexcept {}  // NOLINT(runtime/explicit)
+
+    T* allocate(size_t count) {
+        T* pointer = std::allocator<T>().allocate(count);
+        MemoryTracker::allocated(Tag, count * sizeof(T));
+        return pointer;
+    }
+
+    void deallocate(T* pointer, size_t count) noexcept {
+        MemoryTracker::freed(Tag, count * sizeof(T));
+        std::allocator<T>().deallocate(pointer, count);
+    }
+
+    template <typename U>
+    bool operator==(const TrackedAllocator<U, Tag>&) const noexcept { return true; }
+};
+
+#endif  // SRC_LIB_MEMORYTRACKER_HPP_
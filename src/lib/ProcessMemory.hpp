@@ -0,0 +1,11 @@
+// ProcessMemory.hpp
+
+#ifndef SRC_LIB_PROCESSMEMORY_HPP_
+#define SRC_LIB_PROCESSMEMORY_HPP_
+
+#include <cstddef>
+
+// Peak resident set size of the process in bytes, zero when the platform does not report it
+size_t peakResidentSetBytes();
+
+#endif  // SRC_LIB_PROCESSMEMORY_HPP_
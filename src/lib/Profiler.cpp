@@ -0,0 +1,197 @@
+// Profiler.cpp
+
+#include "Profiler.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <memory_resource>
+
+#include "FrameArena.hpp"
+
+std::atomic<bool> Profiler::enabled_{false};
+
+// Hands the ring back when its thread exits, its pending events are still collected
+struct ProfileRingLease {
+    ProfileRing* ring = nullptr;
+
+    ~ProfileRingLease() {
+        if (ring != nullptr) {
+            Profiler::instance().releaseRing(ring);
+        }
+    }
+};
+
+static thread_local ProfileRingLease tls_lease;
+
+static const double NS_PER_MS = 1000000.0;
+static const double NS_PER_US = 1000.0;
+
+bool ProfileRing::push(const char* name, uint64_t start, uint64_t end) {
+    size_t head = head_.load(std::memory_order_relaxed);
+    if (head - tail_.load(std::memory_order_acquire) >= CAPACITY) {
+        return false;
+    }
+
+    events_[head % CAPACITY] = {name, start, end, thread_};
+    head_.store(head + 1, std::memory_order_release);
+    return true;
+}
+
+Profiler& Profiler::instance() {
+    static Profiler profiler;
+    return profiler;
+}
+
+uint64_t Profiler::now() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+void Profiler::setEnabled(bool enabled) {
+    enabled_.store(enabled, std::memory_order_relaxed);
+}
+
+void Profiler::record(const char* name, uint64_t start, uint64_t end) {
+    if (!threadRing()->push(name, start, end)) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+ProfileRing* Profiler::threadRing() {
+    if (tls_lease.ring == nullptr) {
+        std::lock_guard<std::mutex> lock(rings_mutex_);
+        if (!free_rings_.empty()) {
+            tls_lease.ring = free_rings_.back();
+            free_rings_.pop_back();
+        } else {
+            rings_.push_back(std::make_unique<ProfileRing>(static_cast<uint32_t>(rings_.size())));
+            tls_lease.ring = rings_.back().get();
+        }
+    }
+    return tls_lease.ring;
+}
+
+void Profiler::releaseRing(ProfileRing* ring) {
+    std::lock_guard<std::mutex> lock(rings_mutex_);
+    free_rings_.push_back(ring);
+}
+
+void Profiler::collect() {
+    std::lock_guard<std::mutex> lock(rings_mutex_);
+    for (auto& ring : rings_) {
+        ring->drain([this](const ProfileEvent& event) {
+            // Look up by view so steady state collection does not build strings
+            auto found = history_.find(std::string_view(event.name));
+            if (found == history_.end()) {
+                found = history_.emplace(event.name, ZoneHistory{}).first;
+            }
+            ZoneHistory& zone = found->second;
+            if (zone.durations.size() < ROLLING_WINDOW) {
+                zone.durations.push_back(event.end - event.start);
+            } else {
+                zone.durations[zone.next] = event.end - event.start;
+            }
+            zone.next = (zone.next + 1) % ROLLING_WINDOW;
+
+            if (events_.size() < MAX_TRACE_EVENTS) {
+                events_.push_back(event);
+            } else {
+                events_[events_next_] = event;
+                events_next_ = (events_next_ + 1) % MAX_TRACE_EVENTS;
+            }
+        });
+    }
+}
+
+void Profiler::clear() {
+    collect();
+    events_.clear();
+    events_next_ = 0;
+    history_.clear();
+    dropped_.store(0, std::memory_order_relaxed);
+}
+
+std::vector<ZoneStats> Profiler::stats() const {
+    std::vector<ZoneStats> result;
+    stats(&result);
+    return result;
+}
+
+void Profiler::stats(std::vector<ZoneStats>* result) const {
+    // Scratch copy in the frame arena, the overlay asks for the statistics every frame
+    std::pmr::vector<uint64_t> sorted(&FrameArena::local());
+    sorted.reserve(ROLLING_WINDOW);
+
+    size_t count = 0;
+    for (const auto& [name, zone] : history_) {
+        if (zone.durations.empty()) continue;
+
+        sorted.assign(zone.durations.begin(), zone.durations.end());
+        std::sort(sorted.begin(), sorted.end());
+
+        uint64_t total = 0;
+        for (uint64_t duration : sorted) {
+            total += duration;
+        }
+
+        if (count == result->size()) {
+            result->emplace_back();
+        }
+        ZoneStats& stats = (*result)[count++];
+        stats.name.assign(name);
+        stats.samples = sorted.size();
+        stats.mean_ms = static_cast<double>(total) / sorted.size() / NS_PER_MS;
+        stats.p50_ms = sorted[(sorted.size() - 1) * 50 / 100] / NS_PER_MS;
+        stats.p99_ms = sorted[(sorted.size() - 1) * 99 / 100] / NS_PER_MS;
+        stats.max_ms = sorted.back() / NS_PER_MS;
+    }
+    result->resize(count);
+}
+
+size_t Profiler::dropped() const {
+    return dropped_.load(std::memory_order_relaxed);
+}
+
+size_t Profiler::ringCount() const {
+    std::lock_guard<std::mutex> lock(rings_mutex_);
+    return rings_.size();
+}
+
+static void writeEscaped(std::ostream& out, const char* text) {
+    for (; *text != '\0'; ++text) {
+        if (*text == '"' || *text == '\\') out << '\\';
+        out << *text;
+    }
+}
+
+bool Profiler::exportChromeTrace(const std::string& path) const {
+    std::ofstream file(path);
+    if (!file.is_open()) {
+        std::cerr << "Could not write trace file: " << path << std::endl;
+        return false;
+    }
+
+    uint64_t origin = std::numeric_limits<uint64_t>::max();
+    for (const auto& event : events_) {
+        origin = std::min(origin, event.start);
+    }
+
+    // Complete events ("ph": "X"), timestamps in microseconds from the first event
+    file << std::fixed << std::setprecision(3) << "{\"traceEvents\":[";
+    bool first = true;
+    for (size_t i = 0; i < events_.size(); ++i) {
+        const ProfileEvent& event = events_[(events_next_ + i) % events_.size()];
+        file << (first ? "\n" : ",\n") << "{\"name\":\"";
+        writeEscaped(file, event.name);
+        file << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << event.thread
+             << ",\"ts\":" << (event.start - origin) / NS_PER_US
+             << ",\"dur\":" << (event.end - event.start) / NS_PER_US << "}";
+        first = false;
+    }
+    file << "\n],\"displayTimeUnit\":\"ms\"}" << std::endl;
+    return true;
+}
@@ -0,0 +1,150 @@
+// Profiler.hpp
+
+#ifndef SRC_LIB_PROFILER_HPP_
+#define SRC_LIB_PROFILER_HPP_
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Environment variable holding the Chrome trace path, setting it enables the profiler at start
+constexpr const char* TRACE_ENV = "NODE_MAZE_TRACE";
+
+struct ProfileEvent {
+    const char* name = nullptr;  // Must outlive the profiler, zones use string literals
+    uint64_t start = 0;          // Nanoseconds, steady clock
+    uint64_t end = 0;
+    uint32_t thread = 0;
+};
+
+struct ZoneStats {
+    std::string name;
+    size_t samples = 0;
+    double mean_ms = 0.0;
+    double p50_ms = 0.0;
+    double p99_ms = 0.0;
+    double max_ms = 0.0;
+};
+
+// Single producer, single consumer ring: the owning thread pushes, collect() drains it.
+// Events are dropped when the ring is full instead of blocking the producer.
+class ProfileRing {
+ public:
+    static constexpr size_t CAPACITY = 8192;
+
+    explicit ProfileRing(uint32_t thread) : thread_(thread) {}
+
+    bool push(const char* name, uint64_t start, uint64_t end);
+
+    template <typename Func>
+    void drain(Func&& func) {
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        size_t head = head_.load(std::memory_order_acquire);
+        for (; tail != head; ++tail) {
+            func(events_[tail % CAPACITY]);
+        }
+        tail_.store(tail, std::memory_order_release);
+    }
+
+ private:
+    std::array<ProfileEvent, CAPACITY> events_{};
+    std::atomic<size_t> head_{0};
+    std::atomic<size_t> tail_{0};
+    uint32_t thread_;
+};
+
+struct ProfileRingLease;
+
+// Collects scoped zones from every thread. Recording is lock free, collect() is meant to run once
+// per frame on the main thread and feeds the rolling statistics and the trace history.
+class Profiler {
+ public:
+    static constexpr size_t ROLLING_WINDOW = 240;    // Samples kept per zone for the statistics
+    static constexpr size_t MAX_TRACE_EVENTS = 1 << 20;
+
+    static Profiler& instance();
+
+    static bool enabled() { return enabled_.load(std::memory_order_relaxed); }
+    static uint64_t now();
+
+    void setEnabled(bool enabled);
+    void record(const char* name, uint64_t start, uint64_t end);
+
+    void collect();
+    void clear();
+
+    // Sorted by name, durations over the last ROLLING_WINDOW samples of every zone
+    std::vector<ZoneStats> stats() const;
+    // Same, reuses the entries and name buffers of `result` so per frame calls do not allocate
+    void stats(std::vector<ZoneStats>* result) const;
+    size_t dropped() const;
+    // Rings allocated so far. A thread returns its ring when it exits and the next one reuses it,
+    // so this is bounded by the number of threads recording at the same time.
+    size_t ringCount() const;
+
+    // Writes the collected events as Chrome trace event JSON (chrome://tracing, Perfetto)
+    bool exportChromeTrace(const std::string& path) const;
+
+ private:
+    struct ZoneHistory {
+        std::vector<uint64_t> durations;
+        size_t next = 0;
+    };
+
+    friend struct ProfileRingLease;
+
+    Profiler() = default;
+    ProfileRing* threadRing();
+    void releaseRing(ProfileRing* ring);
+
+    static std::atomic<bool> enabled_;
+
+    mutable std::mutex rings_mutex_;
+    std::vector<std::unique_ptr<ProfileRing>> rings_;  // Every ring, the free ones are still drained
+    std::vector<ProfileRing*> free_rings_;
+    std::atomic<size_t> dropped_{0};
+
+    // Ring of the trace history once it holds MAX_TRACE_EVENTS, the oldest event is at events_next_
+    std::vector<ProfileEvent> events_;
+    size_t events_next_ = 0;
+    std::map<std::string, ZoneHistory, std::less<>> history_;
+};
+
+// Records the lifetime of the scope, only costs a relaxed load while the profiler is disabled
+class ProfileZone {
+ public:
+    explicit ProfileZone(const char* name)
+        : name_(name), start_(Profiler::enabled() ? Profiler::now() : 0) {}
+
+    ~ProfileZone() {
+        if (start_ != 0) {
+            Profiler::instance().record(name_, start_, Profiler::now());
+        }
+    }
+
+    ProfileZone(const ProfileZone&) = delete;
+    ProfileZone& operator=(const ProfileZone&) = delete;
+
+ private:
+    const char* name_;
+    uint64_t start_;
+};
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+
+#ifdef NODE_MAZE_NO_PROFILER
+#define PROFILE_ZONE(name)
+#else
+#define PROFILE_ZONE(name) ProfileZone PROFILE_CONCAT(profile_zone_, __LINE__)(name)
+#endif
+
+#endif  // SRC_LIB_PROFILER_HPP_
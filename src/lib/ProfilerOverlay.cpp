@@ -0,0 +1,21 @@
+// ProfilerOverlay.cpp
+
+#include "ProfilerOverlay.hpp"
+
+#include <cstdio>
+
+static const int OVERLAY_FONT_SIZE = 10;
+static const int OVERLAY_LINE_HEIGHT = 12;
+
+void drawProfilerOverlay(IRenderBackend* backend, const std::vector<ZoneStats>& stats, int x, int y) {
+    char line[128];
+
+    backend->drawText("zone                            mean    p50    p99    max (ms)",
+                      x, y, OVERLAY_FONT_SIZE, DARKGREEN);
+    for (const auto& zone : stats) {
+        y += OVERLAY_LINE_HEIGHT;
+        std::snprintf(line, sizeof(line), "%-30.30s %6.3f %6.3f %6.3f %6.3f",
+                      zone.name.c_str(), zone.mean_ms, zone.p50_ms, zone.p99_ms, zone.max_ms);
+        backend->drawText(line, x, y, OVERLAY_FONT_SIZE, DARKGREEN);
+    }
+}
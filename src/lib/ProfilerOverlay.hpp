@@ -0,0 +1,14 @@
+// ProfilerOverlay.hpp
+
+#ifndef SRC_LIB_PROFILEROVERLAY_HPP_
+#define SRC_LIB_PROFILEROVERLAY_HPP_
+
+#include <vector>
+
+#include "../interfaces/IRenderBackend.hpp"
+#include "Profiler.hpp"
+
+// Draws one line per zone with its rolling mean, p50, p99 and max in milliseconds
+void drawProfilerOverlay(IRenderBackend* backend, const std::vector<ZoneStats>& stats, int x, int y);
+
+#endif  // SRC_LIB_PROFILEROVERLAY_HPP_
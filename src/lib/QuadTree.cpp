@@ -1,6 +1,7 @@
 // QuadTree.cpp
 
 #include "QuadTree.hpp"
+#include "Profiler.hpp"
 #include <algorithm>
 
 const size_t INITIAL_CAPACITY = 10;
@@ -35,6 +36,17 @@ void QuadTree::reset() {
     highestY = -std::numeric_limits<float>::infinity();
 }
 
+void QuadTree::reset(const Rectangle& boundary) {
+    arrayList.clear();
+    Node rootNode;
+    rootNode.boundary = boundary;
+    arrayList.push_back(rootNode);
+    lowestX = std::numeric_limits<float>::infinity();
+    lowestY = std::numeric_limits<float>::infinity();
+    highestX = -std::numeric_limits<float>::infinity();
+    highestY = -std::numeric_limits<float>::infinity();
+}
+
 bool QuadTree::insert(const EntityPosition& point) {
     lowestX = std::min(lowestX, point.x);
     lowestY = std::min(lowestY, point.y);
@@ -68,47 +80,60 @@ bool QuadTree::insertPosition(const EntityPosition& point, unsigned position) {
 }
 
 void QuadTree::subdivide(unsigned position) {
-    Node& node = arrayList[position];
-    float halfWidth = node.boundary.width / 2;
-    float halfHeight = node.boundary.height / 2;
-    float x = node.boundary.x;
-    float y = node.boundary.y;
+    // Copy the boundary and index the node again after the push_backs, they can reallocate
+    Rectangle boundary = arrayList[position].boundary;
+    float halfWidth = boundary.width / 2;
+    float halfHeight = boundary.height / 2;
+    float x = boundary.x;
+    float y = boundary.y;
 
     Rectangle nwBoundary = { x, y, halfWidth, halfHeight };
     Rectangle neBoundary = { x + halfWidth, y, halfWidth, halfHeight };
     Rectangle swBoundary = { x, y + halfHeight, halfWidth, halfHeight };
     Rectangle seBoundary = { x + halfWidth, y + halfHeight, halfWidth, halfHeight };
 
-    node.nw = arrayList.size();
+    unsigned first = static_cast<unsigned>(arrayList.size());
+
     Node nwNode;
     nwNode.boundary = nwBoundary;
     arrayList.push_back(nwNode);
 
-    node.ne = arrayList.size();
     Node neNode;
     neNode.boundary = neBoundary;
     arrayList.push_back(neNode);
 
-    node.sw = arrayList.size();
     Node swNode;
     swNode.boundary = swBoundary;
     arrayList.push_back(swNode);
 
-    node.se = arrayList.size();
     Node seNode;
     seNode.boundary = seBoundary;
     arrayList.push_back(seNode);
 
+    Node& node = arrayList[position];
+    node.nw = first;
+    node.ne = first + 1;
+    node.sw = first + 2;
+    node.se = first + 3;
     node.divided = true;
 }
 
 std::vector<EntityPosition> QuadTree::query(const Rectangle& range) {
+    PROFILE_ZONE("QuadTree::query");
     std::vector<EntityPosition> buffer;
     queryPositionOnBuffer(range, 0, buffer);
     return buffer;
 }
 
-void QuadTree::queryPositionOnBuffer(const Rectangle& range, unsigned position, std::vector<EntityPosition>& buffer) {
+std::pmr::vector<EntityPosition> QuadTree::query(const Rectangle& range, std::pmr::memory_resource* arena) {
+    PROFILE_ZONE("QuadTree::query");
+    std::pmr::vector<EntityPosition> buffer(arena);
+    queryPositionOnBuffer(range, 0, buffer);
+    return buffer;
+}
+
+template <typename Buffer>
+void QuadTree::queryPositionOnBuffer(const Rectangle& range, unsigned position, Buffer& buffer) {
     if (!checkCollision(arrayList[position].boundary, range)) {
         return;
     }
@@ -6,6 +6,11 @@
 #include <limits>
 #include <cstdint>
 #include <array>
+#include <memory_resource>
+
+#include "raylib.h"
+
+#include "MemoryTracker.hpp"
 
 struct EntityPosition {
     uint32_t entity;
@@ -13,13 +18,6 @@ struct EntityPosition {
     float y;
 };
 
-struct Rectangle {
-    float x;
-    float y;
-    float width;
-    float height;
-};
-
 struct Node {
     uint32_t total_elements = 0;
     std::array<EntityPosition, 4> points{};
@@ -35,13 +33,20 @@ class QuadTree {
  public:
     explicit QuadTree(const Rectangle& boundary);
     void reset();
+    // Starts over with `boundary`, keeping the node storage of the previous build
+    void reset(const Rectangle& boundary);
     bool insert(const EntityPosition& point);
     std::vector<EntityPosition> query(const Rectangle& range);
+    // Same as query(), the result lives in `arena` (e.g. the FrameArena of the calling thread)
+    std::pmr::vector<EntityPosition> query(const Rectangle& range, std::pmr::memory_resource* arena);
 
  private:
+    friend class WorldSnapshot;  // Writes and restores the node array as is
+
     void subdivide(unsigned position);
     bool insertPosition(const EntityPosition& point, unsigned position);
-    void queryPositionOnBuffer(const Rectangle& range, unsigned position, std::vector<EntityPosition>& buffer);
+    template <typename Buffer>
+    void queryPositionOnBuffer(const Rectangle& range, unsigned position, Buffer& buffer);
     bool pointInsideBoundary(const EntityPosition& point, unsigned position);
     bool checkCollision(const Rectangle& a, const Rectangle& b);
     unsigned nw(unsigned position);
@@ -49,7 +54,7 @@ class QuadTree {
     unsigned sw(unsigned position);
     unsigned se(unsigned position);
 
-    std::vector<Node> arrayList;
+    std::vector<Node, TrackedAllocator<Node, MemoryTag::SPATIAL_INDEX>> arrayList;
 
     float lowestX;
     float lowestY;
@@ -0,0 +1,58 @@
+// RaylibBackend.cpp
+
+#include "RaylibBackend.hpp"
+
+#include "MemoryTracker.hpp"
+
+// GPU memory is not observable from here, estimated from the size and format of every mip level
+static size_t textureBytes(const Texture2D& texture) {
+    size_t bytes = 0;
+    int width = texture.width;
+    int height = texture.height;
+    for (int level = 0; level < texture.mipmaps && width > 0 && height > 0; ++level) {
+        bytes += static_cast<size_t>(GetPixelDataSize(width, height, texture.format));
+        width = width > 1 ? width / 2 : 1;
+        height = height > 1 ? height / 2 : 1;
+    }
+    return bytes;
+}
+
+Texture2D RaylibBackend::loadTexture(const std::string& path) {
+    Texture2D texture = LoadTexture(path.c_str());
+    if (texture.id != 0) {
+        MemoryTracker::allocated(MemoryTag::TEXTURES, textureBytes(texture));
+    }
+    return texture;
+}
+
+void RaylibBackend::unloadTexture(Texture2D texture) {
+    if (texture.id != 0) {
+        MemoryTracker::freed(MemoryTag::TEXTURES, textureBytes(texture));
+    }
+    UnloadTexture(texture);
+}
+
+void RaylibBackend::beginFrame() {
+    BeginDrawing();
+}
+
+void RaylibBackend::endFrame() {
+    EndDrawing();
+}
+
+void RaylibBackend::clear(Color color) {
+    ClearBackground(color);
+}
+
+void RaylibBackend::drawTexture(Texture2D texture, Rectangle source, Rectangle dest,
+                                Vector2 origin, float rotation, Color tint) {
+    DrawTexturePro(texture, source, dest, origin, rotation, tint);
+}
+
+void RaylibBackend::drawText(const char* text, int x, int y, int font_size, Color color) {
+    DrawText(text, x, y, font_size, color);
+}
+
+void RaylibBackend::drawCircle(Vector2 center, float radius, Color color) {
+    DrawCircleV(center, radius, color);
+}
@@ -0,0 +1,26 @@
+// RaylibBackend.hpp
+
+#ifndef SRC_LIB_RAYLIBBACKEND_HPP_
+#define SRC_LIB_RAYLIBBACKEND_HPP_
+
+#include <string>
+
+#include "../interfaces/IRenderBackend.hpp"
+
+// Forwards every call to raylib, needs a window and must be used from the GL thread
+class RaylibBackend : public IRenderBackend {
+ public:
+    Texture2D loadTexture(const std::string& path) override;
+    void unloadTexture(Texture2D texture) override;
+
+    void beginFrame() override;
+    void endFrame() override;
+
+    void clear(Color color) override;
+    void drawTexture(Texture2D texture, Rectangle source, Rectangle dest,
+                     Vector2 origin, float rotation, Color tint) override;
+    void drawText(const char* text, int x, int y, int font_size, Color color) override;
+    void drawCircle(Vector2 center, float radius, Color color) override;
+};
+
+#endif  // SRC_LIB_RAYLIBBACKEND_HPP_
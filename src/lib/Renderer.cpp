@@ -6,12 +6,20 @@
 #include <sstream>
 #include <nlohmann/json.hpp>
 #include <algorithm>
+#include <cstdio>
 
 #include "../Components.hpp"
 #include "Renderer.hpp"
+#include "Profiler.hpp"
+#include "RaylibBackend.hpp"
 
+// Stateless, shared by every Renderer created without an explicit backend
+static RaylibBackend raylib_backend;
 
-Renderer::Renderer(const std::vector<std::tuple<SpriteLocation, std::string>>& components) {
+
+Renderer::Renderer(const std::vector<std::tuple<SpriteLocation, std::string>>& components,
+                   IRenderBackend* backend)
+    : backend_(backend != nullptr ? backend : &raylib_backend) {
     for (const auto& component : components) {
         SpriteLocation location;
         std::string path;
@@ -65,7 +73,7 @@ void Renderer::LoadTextures(const std::vector<std::tuple<SpriteLocation, std::st
     // If textures are already loaded, unload them first
     if (!textures_.empty()) {
         for (auto& texture : textures_) {
-            UnloadTexture(texture);
+            backend_->unloadTexture(texture);
         }
         textures_.clear();
     }
@@ -77,12 +85,25 @@ void Renderer::LoadTextures(const std::vector<std::tuple<SpriteLocation, std::st
         std::string path;
         std::tie(location, path) = component;
 
-        Texture2D texture = LoadTexture(path.c_str());
+        Texture2D texture = backend_->loadTexture(path);
         textures_[location] = texture;
     }
 }
 
-const std::unordered_map<std::string, MappingPosition>& Renderer::getSpriteMap() {
+void Renderer::setView(const Rectangle& view) {
+    view_ = view;
+    has_view_ = true;
+}
+
+void Renderer::clearView() {
+    has_view_ = false;
+}
+
+void Renderer::setAnimationLod(const AnimationLod& lod) {
+    lod_ = lod;
+}
+
+const SpriteMap& Renderer::getSpriteMap() {
     return sprite_map_;
 }
 
@@ -93,39 +114,106 @@ int compare_renders(flecs::entity_t e1, const Render* a, flecs::entity_t e2, con
 }
 
 void Renderer::Execute(world* ecs) {
+  RegisterAnimationSystem(ecs);
+  RegisterRenderSystem(ecs);
+}
+
+void Renderer::RegisterRenderSystem(world* ecs) {
   ecs->system<Render>("Render System")
+      .kind(flecs::OnStore)
       .order_by<Render>(compare_renders)
-      .each([this](flecs::entity e, Render& render) {
-        // Draw the texture
-        DrawTexturePro(textures_[render.sprite.location],
-                       {.x = static_cast<float>(render.sprite.x),
-                        .y = static_cast<float>(render.sprite.y),
-                        .width = static_cast<float>(render.sprite.width),
-                        .height = static_cast<float>(render.sprite.height)},
-                       {.x = render.position.x,
-                        .y = render.position.y,
-                        .width = static_cast<float>(render.sprite.width),
-                        .height = static_cast<float>(render.sprite.height)},
-                       {static_cast<float>(render.sprite.width),
-                        static_cast<float>(render.sprite.height)},
-                       0.0f, WHITE);
+      .run([this](flecs::iter& it) {
+        PROFILE_ZONE("Render System");
+        while (it.next()) {
+          auto renders = it.field<Render>(0);
+          for (auto i : it) {
+            draw(renders[i]);
+          }
+        }
       });
+}
+
+void Renderer::RegisterAnimationSystem(world* ecs) {
+  ecs->system<Render, Animation>("Animation System")
+      .kind(flecs::OnUpdate)
+      .multi_threaded()
+      .run([this](flecs::iter& it) {
+        // One zone per worker, each one iterates its own slice of the tables
+        PROFILE_ZONE("Animation System");
+        // Animations store the world time they were advanced to, skipped frames are caught up later
+        const ecs_world_info_t* info = it.world().get_info();
+        float now = info->world_time_total;
+        uint64_t frame = static_cast<uint64_t>(info->frame_count_total);
+        while (it.next()) {
+          auto renders = it.field<Render>(0);
+          auto animations = it.field<Animation>(1);
+          for (auto i : it) {
+            Animation& animation = animations[i];
+            if (animation.synced_at < 0.0f) {
+              animation.synced_at = now - it.delta_time();
+            }
+            if (!shouldAnimate(renders[i], it.entity(i).id(), frame)) continue;
 
-  ecs->system<Render, Animation>().each(
-      [this](flecs::entity e, Render& render, Animation& animation) {
-        if (animation.current_frame > 0.2) {
-          animation.current_frame = 0.0f;
-          animation.actual_frame++;
-          if (animation.actual_frame > animation.total_frames) {
-            animation.actual_frame = 1;
+            animate(renders[i], animation, now - animation.synced_at);
+            animation.synced_at = now;
           }
-          std::ostringstream oss;
-          oss << animation.name.substr(0, animation.name.find_last_of('_') + 1)
-              << std::setw(4) << std::setfill('0') << animation.actual_frame;
-          animation.name = oss.str();
-          render.sprite = sprite_map_[animation.name];
-        } else {
-          animation.current_frame += GetFrameTime();
         }
       });
 }
+
+void Renderer::draw(const Render& render) {
+  backend_->drawTexture(textures_[render.sprite.location],
+                        {.x = static_cast<float>(render.sprite.x),
+                         .y = static_cast<float>(render.sprite.y),
+                         .width = static_cast<float>(render.sprite.width),
+                         .height = static_cast<float>(render.sprite.height)},
+                        {.x = render.position.x,
+                         .y = render.position.y,
+                         .width = static_cast<float>(render.sprite.width),
+                         .height = static_cast<float>(render.sprite.height)},
+                        {static_cast<float>(render.sprite.width),
+                         static_cast<float>(render.sprite.height)},
+                        0.0f, WHITE);
+}
+
+bool Renderer::shouldAnimate(const Render& render, flecs::entity_t entity, uint64_t frame) const {
+  if (!has_view_) return true;
+
+  // Sprites are drawn with their bottom right corner on the position
+  float left = render.position.x - static_cast<float>(render.sprite.width);
+  float top = render.position.y - static_cast<float>(render.sprite.height);
+  if (render.position.x < view_.x || left > view_.x + view_.width ||
+      render.position.y < view_.y || top > view_.y + view_.height) {
+    return false;
+  }
+
+  if (lod_.full_rate_distance <= 0.0f || lod_.reduced_interval <= 1) return true;
+
+  float dx = render.position.x - (view_.x + view_.width / 2);
+  float dy = render.position.y - (view_.y + view_.height / 2);
+  if (dx * dx + dy * dy <= lod_.full_rate_distance * lod_.full_rate_distance) return true;
+
+  // Stagger by entity so the reduced rate entities do not all update on the same frame
+  return (frame + entity) % lod_.reduced_interval == 0;
+}
+
+// Closed form, advancing by the sum of several steps lands on the same frame as advancing step by
+// step, which lets skipped entities catch up in O(1)
+void Renderer::animate(Render& render, Animation& animation, float elapsed) const {
+  animation.current_frame += elapsed;
+  if (animation.current_frame >= ANIMATION_FRAME_TIME && animation.total_frames > 0) {
+    unsigned steps = static_cast<unsigned>(animation.current_frame / ANIMATION_FRAME_TIME);
+    animation.current_frame -= static_cast<float>(steps) * ANIMATION_FRAME_TIME;
+    animation.actual_frame = (animation.actual_frame - 1 + steps % animation.total_frames) % animation.total_frames + 1;
+
+    // Rewrite the frame number in place, the name keeps its capacity so nothing is allocated
+    char digits[16];
+    int length = std::snprintf(digits, sizeof(digits), "%04u", animation.actual_frame);
+    animation.name.replace(animation.name.find_last_of('_') + 1, std::string::npos, digits, length);
+    // find() instead of operator[] so worker threads never insert into the shared map
+    auto sprite = sprite_map_.find(animation.name);
+    if (sprite != sprite_map_.end()) {
+      render.sprite = sprite->second;
+    }
+  }
+}
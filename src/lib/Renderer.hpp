@@ -1,4 +1,7 @@
-// #include <flecs.h>
+// Renderer.hpp
+
+#ifndef SRC_LIB_RENDERER_HPP_
+#define SRC_LIB_RENDERER_HPP_
 
 #include <vector>
 #include <map>
@@ -8,17 +11,62 @@
 
 #include "../Components.hpp"
 #include "../interfaces/IExecutes.hpp"
+#include "../interfaces/IRenderBackend.hpp"
+#include "MemoryTracker.hpp"
 
 using flecs::world;
 
+// Seconds an animation frame stays on screen before advancing
+const float ANIMATION_FRAME_TIME = 0.2f;
+
+// Nodes and buckets are accounted to MemoryTag::SPRITE_MAP, the heap buffers of long keys are not
+using SpriteMap = std::unordered_map<std::string, MappingPosition, std::hash<std::string>, std::equal_to<std::string>,
+                                     TrackedAllocator<std::pair<const std::string, MappingPosition>, MemoryTag::SPRITE_MAP>>;
+
+// Animations far from the center of the view are advanced every `reduced_interval` frames only
+struct AnimationLod {
+    float full_rate_distance = 0.0f;  // Zero animates every visible entity at the full rate
+    unsigned reduced_interval = 4;
+};
+
 class Renderer : public IExecutes {
  public:
-    explicit Renderer(const std::vector<std::tuple<SpriteLocation, std::string>>& components);
+    // Draws through `backend` when given (e.g. a HeadlessBackend), through raylib otherwise
+    explicit Renderer(const std::vector<std::tuple<SpriteLocation, std::string>>& components,
+                      IRenderBackend* backend = nullptr);
     void LoadTextures(const std::vector<std::tuple<SpriteLocation, std::string>>& components);
 
+    // Registers both the animation and the render systems
     void Execute(world* ecs) override;
-    const std::unordered_map<std::string, MappingPosition>& getSpriteMap();
+
+    // Animation runs on the OnUpdate phase and is safe to spread over flecs worker threads:
+    // it only touches the entity it iterates and reads sprite_map_ without modifying it.
+    void RegisterAnimationSystem(world* ecs);
+
+    // Rendering runs on the OnStore phase, single threaded, so it stays on the GL thread and
+    // sees the state left by the OnUpdate sync point.
+    void RegisterRenderSystem(world* ecs);
+
+    // Entities whose sprite is outside of `view` keep their animation untouched, they catch up with
+    // the world time in one step once they are visible again. Without a view everything is visible.
+    void setView(const Rectangle& view);
+    void clearView();
+    void setAnimationLod(const AnimationLod& lod);
+
+    const SpriteMap& getSpriteMap();
  private:
-    std::unordered_map<std::string, MappingPosition> sprite_map_;
+    void draw(const Render& render);
+    bool shouldAnimate(const Render& render, flecs::entity_t entity, uint64_t frame) const;
+    void animate(Render& render, Animation& animation, float elapsed) const;
+
+    SpriteMap sprite_map_;
     std::vector<Texture2D> textures_;
+    IRenderBackend* backend_;
+
+    // Written between frames only, the animation workers read them during progress()
+    Rectangle view_{};
+    bool has_view_ = false;
+    AnimationLod lod_;
 };
+
+#endif  // SRC_LIB_RENDERER_HPP_
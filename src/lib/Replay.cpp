@@ -0,0 +1,141 @@
+// Replay.cpp
+
+#include "Replay.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <iomanip>
+
+#include "FrameArena.hpp"
+#include "Game.hpp"
+#include "HeadlessBackend.hpp"
+#include "InputLog.hpp"
+#include "Renderer.hpp"
+#include "Workers.hpp"
+
+bool parseReplayOptions(int argc, char** argv, ReplayOptions* options, std::string* error) {
+    // --workers also belongs to the stress mode, it is only validated for a replay
+    bool replay = false;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--replay") == 0) replay = true;
+    }
+    if (!replay) return false;
+
+    for (int i = 1; i < argc; ++i) {
+        bool is_replay = std::strcmp(argv[i], "--replay") == 0;
+        bool is_workers = std::strcmp(argv[i], "--workers") == 0;
+        if (!is_replay && !is_workers) continue;
+
+        if (i + 1 >= argc) {
+            *error = std::string("Expected a value after ") + argv[i];
+            return true;
+        }
+        if (is_replay) {
+            options->log = argv[i + 1];
+        } else {
+            char* end = nullptr;
+            long parsed = std::strtol(argv[i + 1], &end, 10);
+            if (*end != '\0' || parsed < 1) {
+                *error = std::string("Expected a positive number after ") + argv[i];
+                return true;
+            }
+            // Clamped like NODE_MAZE_WORKERS, flecs cannot run more threads
+            options->workers = static_cast<unsigned>(std::min<long>(parsed, MAX_WORKERS));
+        }
+        ++i;
+    }
+    return true;
+}
+
+const char* parseRecordPath(int argc, char** argv, std::string* error) {
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--record") != 0) continue;
+
+        if (i + 1 >= argc) {
+            *error = "Expected a path after --record";
+            return nullptr;
+        }
+        return argv[i + 1];
+    }
+    return nullptr;
+}
+
+ReplayReport runReplay(const ReplayOptions& options) {
+    ReplayReport report;
+    report.workers = options.workers != 0 ? options.workers : resolveWorkerCount(std::getenv(WORKERS_ENV));
+
+    InputReplay input;
+    if (!input.load(options.log, &report.error)) {
+        return report;
+    }
+
+    HeadlessBackend backend;
+    Renderer renderer({{CHARACTERS, options.atlas}}, &backend);
+    renderer.LoadTextures({{CHARACTERS, "characters.png"}});
+
+    // Same setup order as the recording, entity ids and system order have to match
+    flecs::world ecs;
+    ecs.set_threads(static_cast<int32_t>(report.workers));
+    GameState state = createGame(&ecs, &renderer);
+    renderer.Execute(&ecs);
+
+    // The checkpoint keys of the log go to a scratch file, a replay never touches the checkpoint of
+    // the player. It starts empty like a fresh session, a load before the first save fails.
+    std::string checkpoint_path = (std::filesystem::temp_directory_path() / REPLAY_CHECKPOINT_FILE).string();
+    std::error_code ignored;
+    std::filesystem::remove(checkpoint_path, ignored);
+
+    FrameInput frame_input;
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned frame = 0; input.poll(&frame_input); ++frame) {
+        updateGame(&state, frame_input);
+        applyCheckpointInput(frame_input, checkpoint_path, &state, &ecs);
+
+        backend.beginFrame();
+        backend.clear(RAYWHITE);
+        ecs.progress(frame_input.delta_time);
+        backend.drawCircle(state.ball_position, BALL_RADIUS, MAROON);
+        backend.endFrame();
+        FrameArena::resetAll();
+        report.frames++;
+
+        uint64_t expected = 0;
+        if (!input.checkpoint(frame, &expected)) continue;
+
+        uint64_t actual = hashGame(state, &ecs);
+        if (actual != expected) {
+            report.diverged = true;
+            report.divergence_frame = frame;
+            report.expected_hash = expected;
+            report.actual_hash = actual;
+            break;
+        }
+        report.checkpoints++;
+    }
+    std::filesystem::remove(checkpoint_path, ignored);
+    report.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    report.frames_per_second = report.seconds > 0.0 ? report.frames / report.seconds : 0.0;
+    return report;
+}
+
+void printReplayReport(std::ostream& out, const ReplayReport& report) {
+    if (!report.error.empty()) {
+        out << "Replay failed: " << report.error << std::endl;
+        return;
+    }
+
+    std::ios_base::fmtflags flags = out.flags();
+    out << std::fixed << std::setprecision(2)
+        << "Replay: " << report.frames << " frames, " << report.workers << " workers\n"
+        << "  total time        " << report.seconds << " s (" << report.frames_per_second << " frames/s)\n"
+        << "  checkpoints       " << report.checkpoints << " matched\n";
+    if (report.diverged) {
+        out << "  DIVERGED at frame " << report.divergence_frame << std::hex
+            << ": expected 0x" << report.expected_hash << ", got 0x" << report.actual_hash << "\n";
+    }
+    out.flush();
+    out.flags(flags);
+}
@@ -0,0 +1,48 @@
+// Replay.hpp
+
+#ifndef SRC_LIB_REPLAY_HPP_
+#define SRC_LIB_REPLAY_HPP_
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+// World hash checkpoints are written every CHECKPOINT_INTERVAL frames while recording
+constexpr unsigned CHECKPOINT_INTERVAL = 60;
+// Scratch file in the temp directory for the checkpoint keys of a replayed log
+constexpr const char* REPLAY_CHECKPOINT_FILE = "node_maze_replay_checkpoint.nmws";
+
+struct ReplayOptions {
+    std::string log;
+    unsigned workers = 0;  // Zero resolves NODE_MAZE_WORKERS / the hardware concurrency
+    std::string atlas = "resources/characters.json";
+};
+
+struct ReplayReport {
+    std::string error;       // Set when the log could not be read, nothing was replayed
+    unsigned frames = 0;
+    unsigned workers = 0;
+    unsigned checkpoints = 0;  // Checkpoints verified
+    bool diverged = false;
+    unsigned divergence_frame = 0;
+    uint64_t expected_hash = 0;
+    uint64_t actual_hash = 0;
+    double seconds = 0.0;
+    double frames_per_second = 0.0;
+};
+
+// Reads `--replay <log> [--workers W]`. Returns whether --replay was given, `error` is filled when
+// one of the values is missing or invalid. W is clamped to MAX_WORKERS.
+bool parseReplayOptions(int argc, char** argv, ReplayOptions* options, std::string* error);
+
+// Path after `--record`, nullptr when the argument is missing. `error` is filled when --record has
+// no path.
+const char* parseRecordPath(int argc, char** argv, std::string* error);
+
+// Plays the log back through the same frame pipeline as the game with a headless backend, as fast
+// as possible with the recorded fixed step. Stops at the first checkpoint whose hash differs.
+ReplayReport runReplay(const ReplayOptions& options);
+
+void printReplayReport(std::ostream& out, const ReplayReport& report);
+
+#endif  // SRC_LIB_REPLAY_HPP_
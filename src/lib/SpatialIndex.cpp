@@ -0,0 +1,59 @@
+// SpatialIndex.cpp
+
+#include "SpatialIndex.hpp"
+#include "Profiler.hpp"
+
+#include <algorithm>
+#include <limits>
+
+static const float INDEX_GUTTER = 20.0f;
+
+SpatialIndex::SpatialIndex() : tree_({0.0f, 0.0f, 0.0f, 0.0f}) {}
+
+JobHandle SpatialIndex::ExecuteAsync(flecs::world* ecs, JobSystem* jobs) {
+    PROFILE_ZONE("SpatialIndex snapshot");
+    positions_.clear();
+    ecs->each([this](flecs::entity e, const Render& render) {
+        positions_.push_back({static_cast<uint32_t>(e.id()), render.position.x, render.position.y});
+    });
+
+    return jobs->submit([this]() { rebuild(); });
+}
+
+std::vector<EntityPosition> SpatialIndex::query(const Rectangle& range) {
+    return tree_.query(range);
+}
+
+std::pmr::vector<EntityPosition> SpatialIndex::query(const Rectangle& range, std::pmr::memory_resource* arena) {
+    return tree_.query(range, arena);
+}
+
+void SpatialIndex::rebuild() {
+    PROFILE_ZONE("SpatialIndex rebuild");
+    float lowestX = std::numeric_limits<float>::infinity();
+    float lowestY = std::numeric_limits<float>::infinity();
+    float highestX = -std::numeric_limits<float>::infinity();
+    float highestY = -std::numeric_limits<float>::infinity();
+    for (const auto& position : positions_) {
+        lowestX = std::min(lowestX, position.x);
+        lowestY = std::min(lowestY, position.y);
+        highestX = std::max(highestX, position.x);
+        highestY = std::max(highestY, position.y);
+    }
+
+    if (positions_.empty()) {
+        tree_.reset({0.0f, 0.0f, 0.0f, 0.0f});
+        return;
+    }
+
+    // Reuses the node storage of the previous frame
+    tree_.reset({
+        lowestX - INDEX_GUTTER,
+        lowestY - INDEX_GUTTER,
+        (highestX - lowestX) + INDEX_GUTTER * 2,
+        (highestY - lowestY) + INDEX_GUTTER * 2
+    });
+    for (const auto& position : positions_) {
+        tree_.insert(position);
+    }
+}
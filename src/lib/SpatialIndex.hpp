@@ -0,0 +1,31 @@
+// SpatialIndex.hpp
+
+#ifndef SRC_LIB_SPATIALINDEX_HPP_
+#define SRC_LIB_SPATIALINDEX_HPP_
+
+#include <vector>
+
+#include "../Components.hpp"
+#include "../interfaces/IExecutesAsync.hpp"
+#include "QuadTree.hpp"
+
+// QuadTree over the positions of every Render entity, rebuilt as a job
+class SpatialIndex : public IExecutesAsync {
+ public:
+    SpatialIndex();
+
+    // Copies the positions on the calling thread and rebuilds the tree on a worker, the tree must
+    // not be queried until the returned handle is done.
+    JobHandle ExecuteAsync(flecs::world* ecs, JobSystem* jobs) override;
+
+    std::vector<EntityPosition> query(const Rectangle& range);
+    std::pmr::vector<EntityPosition> query(const Rectangle& range, std::pmr::memory_resource* arena);
+
+ private:
+    void rebuild();
+
+    QuadTree tree_;
+    std::vector<EntityPosition, TrackedAllocator<EntityPosition, MemoryTag::SPATIAL_INDEX>> positions_;
+};
+
+#endif  // SRC_LIB_SPATIALINDEX_HPP_
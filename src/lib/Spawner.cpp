@@ -0,0 +1,90 @@
+// Spawner.cpp
+
+#include "Spawner.hpp"
+
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include "Profiler.hpp"
+
+Spawner::Spawner(flecs::world* ecs)
+    : ecs_(ecs),
+      render_id_(ecs->component<Render>().id()),
+      animation_id_(ecs->component<Animation>().id()) {}
+
+flecs::entity Spawner::prefab(const char* name, const Render& render, const Animation& animation) {
+    return ecs_->prefab(name)
+        .set<Render>(render)
+        .set<Animation>(animation);
+}
+
+// ecs_bulk_init moves out of the arrays it is given: Render has no move hook, Animation owns a string
+static_assert(std::is_trivially_copyable_v<Render>, "Render columns are handed to flecs without a copy");
+
+static void checkSizes(size_t renders, size_t animations) {
+    if (animations != renders) {
+        throw std::invalid_argument("Spawner: " + std::to_string(renders) + " renders but " +
+                                    std::to_string(animations) + " animations");
+    }
+}
+
+std::vector<flecs::entity_t> Spawner::spawn(flecs::entity prefab, std::span<const Render> renders,
+                                            std::span<const Animation> animations) {
+    if (animations.empty()) {
+        return bulk(prefab, renders.size(), renders.data(), nullptr);
+    }
+    return spawn(prefab, renders, std::vector<Animation>(animations.begin(), animations.end()));
+}
+
+std::vector<flecs::entity_t> Spawner::spawn(flecs::entity prefab, std::span<const Render> renders,
+                                            std::vector<Animation>&& animations) {
+    if (animations.empty()) {
+        return bulk(prefab, renders.size(), renders.data(), nullptr);
+    }
+    checkSizes(renders.size(), animations.size());
+    std::vector<Animation> consumed = std::move(animations);
+    return bulk(prefab, renders.size(), renders.data(), consumed.data());
+}
+
+std::vector<flecs::entity_t> Spawner::spawn(flecs::entity prefab, size_t count) {
+    return bulk(prefab, count, nullptr, nullptr);
+}
+
+std::vector<flecs::entity_t> Spawner::spawn(std::span<const Render> renders,
+                                            std::span<const Animation> animations) {
+    checkSizes(renders.size(), animations.size());
+    return spawn(renders, std::vector<Animation>(animations.begin(), animations.end()));
+}
+
+std::vector<flecs::entity_t> Spawner::spawn(std::span<const Render> renders,
+                                            std::vector<Animation>&& animations) {
+    checkSizes(renders.size(), animations.size());
+    std::vector<Animation> consumed = std::move(animations);
+    return bulk(flecs::entity(), renders.size(), renders.data(), consumed.data());
+}
+
+std::vector<flecs::entity_t> Spawner::bulk(flecs::entity prefab, size_t count, const Render* renders,
+                                           Animation* animations) {
+    PROFILE_ZONE("Spawner::spawn");
+    if (count == 0) return {};
+
+    // The IsA pair copies the prefab components into every instance, the arrays then overwrite the
+    // columns they are given for. Null entries keep the copied prefab values.
+    void* data[3] = {};
+    ecs_bulk_desc_t desc = {};
+    desc.count = static_cast<int32_t>(count);
+    int ids = 0;
+    if (prefab.id() != 0) {
+        desc.ids[ids++] = ecs_pair(EcsIsA, prefab.id());
+    }
+    data[ids] = const_cast<Render*>(renders);
+    desc.ids[ids++] = render_id_;
+    data[ids] = animations;
+    desc.ids[ids++] = animation_id_;
+    desc.data = (renders != nullptr || animations != nullptr) ? data : nullptr;
+
+    const ecs_entity_t* entities = ecs_bulk_init(ecs_->c_ptr(), &desc);
+    return std::vector<flecs::entity_t>(entities, entities + count);
+}
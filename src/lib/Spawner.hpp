@@ -0,0 +1,47 @@
+// Spawner.hpp
+
+#ifndef SRC_LIB_SPAWNER_HPP_
+#define SRC_LIB_SPAWNER_HPP_
+
+#include <span>
+#include <vector>
+
+#include "../Components.hpp"
+#include "flecs.h"
+
+// Creates Render + Animation entities in bulk. Every entity of a spawn call goes straight to its final
+// archetype table in one operation instead of moving table on every chained .set<>().
+class Spawner {
+ public:
+    explicit Spawner(flecs::world* ecs);
+
+    // Registers a prefab, its instances start as copies of its Render and Animation
+    flecs::entity prefab(const char* name, const Render& render, const Animation& animation);
+
+    // Creates renders.size() instances of `prefab`, the i-th one gets renders[i]. `animations` is
+    // either empty, which keeps the Animation of the prefab, or holds one value per entity.
+    // Throws std::invalid_argument when the sizes differ.
+    std::vector<flecs::entity_t> spawn(flecs::entity prefab, std::span<const Render> renders,
+                                       std::span<const Animation> animations = {});
+    // Same, the animations are moved into the entities instead of copied and left empty
+    std::vector<flecs::entity_t> spawn(flecs::entity prefab, std::span<const Render> renders,
+                                       std::vector<Animation>&& animations);
+
+    // Creates `count` plain copies of `prefab`
+    std::vector<flecs::entity_t> spawn(flecs::entity prefab, size_t count);
+
+    // Creates renders.size() entities without a prefab, both arrays hold one value per entity
+    std::vector<flecs::entity_t> spawn(std::span<const Render> renders, std::span<const Animation> animations);
+    std::vector<flecs::entity_t> spawn(std::span<const Render> renders, std::vector<Animation>&& animations);
+
+ private:
+    // flecs moves the given columns into the new entities, `animations` is consumed
+    std::vector<flecs::entity_t> bulk(flecs::entity prefab, size_t count, const Render* renders,
+                                      Animation* animations);
+
+    flecs::world* ecs_;
+    flecs::entity_t render_id_;
+    flecs::entity_t animation_id_;
+};
+
+#endif  // SRC_LIB_SPAWNER_HPP_
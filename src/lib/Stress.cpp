@@ -0,0 +1,233 @@
+// Stress.cpp
+
+#include "Stress.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <memory_resource>
+#include <set>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "../Components.hpp"
+#include "AllocationCounter.hpp"
+#include "FrameArena.hpp"
+#include "HeadlessBackend.hpp"
+#include "JobSystem.hpp"
+#include "ProcessMemory.hpp"
+#include "Profiler.hpp"
+#include "Renderer.hpp"
+#include "SpatialIndex.hpp"
+#include "Spawner.hpp"
+#include "Workers.hpp"
+
+static const float SPAWN_SPACING = 16.0f;
+static const double BYTES_PER_MIB = 1024.0 * 1024.0;
+
+struct AnimationTemplate {
+    std::string first_frame;
+    unsigned total_frames = 0;
+};
+
+static bool parseCount(const char* value, unsigned* count) {
+    char* end = nullptr;
+    long long parsed = std::strtoll(value, &end, 10);
+    if (end == value || *end != '\0' || parsed < 1 || parsed > std::numeric_limits<unsigned>::max()) {
+        return false;
+    }
+    *count = static_cast<unsigned>(parsed);
+    return true;
+}
+
+bool parseStressOptions(int argc, char** argv, StressOptions* options, std::string* error) {
+    // The counts only mean something in stress mode, other launches ignore them
+    bool stress = false;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--stress") == 0) stress = true;
+    }
+    if (!stress) return false;
+
+    for (int i = 1; i < argc; ++i) {
+
+        unsigned* target = nullptr;
+        if (std::strcmp(argv[i], "--entities") == 0) target = &options->entities;
+        if (std::strcmp(argv[i], "--frames") == 0) target = &options->frames;
+        if (std::strcmp(argv[i], "--workers") == 0) target = &options->workers;
+        if (target == nullptr) continue;
+
+        if (i + 1 >= argc || !parseCount(argv[i + 1], target)) {
+            *error = std::string("Expected a positive number after ") + argv[i];
+            return true;
+        }
+        // Clamped like NODE_MAZE_WORKERS, flecs cannot run more threads
+        options->workers = std::min(options->workers, MAX_WORKERS);
+        ++i;
+    }
+    return true;
+}
+
+// Animations of the atlas: sprites named <prefix>_NNNN with contiguous frames from 0001
+static std::vector<AnimationTemplate> findAnimations(const SpriteMap& sprite_map) {
+    std::set<std::string> prefixes;  // Sorted, spawning must not depend on the hash map order
+    for (const auto& entry : sprite_map) {
+        const std::string& key = entry.first;
+        size_t underscore = key.find_last_of('_');
+        if (underscore != std::string::npos && key.compare(underscore + 1, std::string::npos, "0001") == 0) {
+            prefixes.insert(key.substr(0, underscore + 1));
+        }
+    }
+
+    std::vector<AnimationTemplate> animations;
+    char digits[16];
+    for (const auto& prefix : prefixes) {
+        AnimationTemplate animation;
+        animation.first_frame = prefix + "0001";
+        while (true) {
+            std::snprintf(digits, sizeof(digits), "%04u", animation.total_frames + 1);
+            if (sprite_map.find(prefix + digits) == sprite_map.end()) break;
+            animation.total_frames++;
+        }
+        animations.push_back(animation);
+    }
+    return animations;
+}
+
+static void spawn(flecs::world& ecs, Renderer& renderer, const std::vector<AnimationTemplate>& animations,
+                  unsigned count) {
+    const auto& sprite_map = renderer.getSpriteMap();
+    unsigned side = static_cast<unsigned>(std::ceil(std::sqrt(static_cast<double>(count))));
+
+    std::vector<Render> renders(count);
+    std::vector<Animation> states(count);
+    for (unsigned i = 0; i < count; ++i) {
+        const AnimationTemplate& animation = animations[i % animations.size()];
+        renders[i] = {
+            .z_index = static_cast<int>(i),
+            .position = { (i % side) * SPAWN_SPACING, (i / side) * SPAWN_SPACING },
+            .sprite = sprite_map.at(animation.first_frame) };
+        states[i] = {
+            .name = animation.first_frame,
+            .actual_frame = 1,
+            .total_frames = animation.total_frames,
+            .current_frame = static_cast<float>(i % 10) * 0.02f };
+    }
+
+    Spawner spawner(&ecs);
+    flecs::entity prefab = spawner.prefab("StressCharacter", renders[0], states[0]);
+    spawner.spawn(prefab, renders, std::move(states));
+}
+
+static double percentile(const std::vector<double>& sorted, unsigned percent) {
+    if (sorted.empty()) return 0.0;
+    return sorted[(sorted.size() - 1) * percent / 100];
+}
+
+StressReport runStress(const StressOptions& options) {
+    StressReport report;
+    report.workers = options.workers != 0 ? options.workers : resolveWorkerCount(std::getenv(WORKERS_ENV));
+
+    HeadlessBackend backend;
+    Renderer renderer({{CHARACTERS, options.atlas}}, &backend);
+    renderer.LoadTextures({{CHARACTERS, "characters.png"}});
+
+    std::vector<AnimationTemplate> animations = findAnimations(renderer.getSpriteMap());
+    if (animations.empty()) {
+        report.error = "No animations found in atlas: " + options.atlas;
+        return report;
+    }
+
+    flecs::world ecs;
+    ecs.set_threads(static_cast<int32_t>(report.workers));
+    renderer.Execute(&ecs);
+    spawn(ecs, renderer, animations, options.entities);
+
+    JobSystem jobs;
+    SpatialIndex spatialIndex;
+
+    std::vector<double> frame_ms;
+    frame_ms.reserve(options.frames);
+    uint64_t allocations = 0;
+    uint64_t ecs_allocations = 0;
+    const Rectangle view = {0.0f, 0.0f, STRESS_VIEW_WIDTH, STRESS_VIEW_HEIGHT};
+
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned frame = 0; frame < options.frames; ++frame) {
+        PROFILE_ZONE("Frame");
+        auto frame_start = std::chrono::steady_clock::now();
+        uint64_t allocations_at_start = heapAllocations();
+        uint64_t ecs_allocations_at_start = MemoryTracker::stats(MemoryTag::ECS).allocations;
+
+        JobHandle indexed = spatialIndex.ExecuteAsync(&ecs, &jobs);
+        backend.beginFrame();
+        backend.clear(RAYWHITE);
+        ecs.progress(options.time_step);
+        backend.endFrame();
+        jobs.wait(indexed);
+
+        // Per frame gameplay query, the result lives in the frame arena until the reset below
+        std::pmr::vector<EntityPosition> visible = spatialIndex.query(view, &FrameArena::local());
+        report.visible_entities = visible.size();
+
+        FrameArena::resetAll();
+        Profiler::instance().collect();
+
+        // The first frame builds the query caches and the arenas, it is not steady state
+        if (frame > 0) {
+            allocations += heapAllocations() - allocations_at_start;
+            ecs_allocations += MemoryTracker::stats(MemoryTag::ECS).allocations - ecs_allocations_at_start;
+        }
+        frame_ms.push_back(std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - frame_start).count());
+    }
+    report.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::sort(frame_ms.begin(), frame_ms.end());
+    report.entities = options.entities;
+    report.frames = options.frames;
+    report.frames_per_second = report.seconds > 0.0 ? options.frames / report.seconds : 0.0;
+    report.entities_per_second = report.frames_per_second * options.entities;
+    report.p50_ms = percentile(frame_ms, 50);
+    report.p99_ms = percentile(frame_ms, 99);
+    report.max_ms = frame_ms.empty() ? 0.0 : frame_ms.back();
+    report.heap_allocations_per_frame = options.frames > 1
+        ? static_cast<double>(allocations) / (options.frames - 1) : 0.0;
+    report.ecs_allocations_per_frame = options.frames > 1
+        ? static_cast<double>(ecs_allocations) / (options.frames - 1) : 0.0;
+    report.peak_rss_bytes = peakResidentSetBytes();
+    report.last_frame_hash = backend.frameHash();
+    report.memory = MemoryTracker::report();
+    return report;
+}
+
+void printStressReport(std::ostream& out, const StressReport& report) {
+    if (!report.error.empty()) {
+        out << "Stress test failed: " << report.error << std::endl;
+        return;
+    }
+    std::ios_base::fmtflags flags = out.flags();
+    out << std::fixed << std::setprecision(2)
+        << "Stress test: " << report.entities << " entities, " << report.frames << " frames, "
+        << report.workers << " workers\n"
+        << "  total time        " << report.seconds << " s\n"
+        << "  throughput        " << report.frames_per_second << " frames/s, "
+        << report.entities_per_second << " entities/s\n"
+        << "  frame time        p50 " << report.p50_ms << " ms, p99 " << report.p99_ms
+        << " ms, max " << report.max_ms << " ms\n"
+        << "  heap allocations  " << report.heap_allocations_per_frame << " per frame, flecs "
+        << report.ecs_allocations_per_frame << " per frame\n"
+        << "  visible entities  " << report.visible_entities << "\n"
+        << "  peak RSS          " << report.peak_rss_bytes / BYTES_PER_MIB << " MiB\n"
+        << "  last frame hash   0x" << std::hex << report.last_frame_hash << std::endl;
+    out.flags(flags);
+    if (!report.memory.empty()) {
+        printMemoryReport(out, report.memory);
+    }
+}
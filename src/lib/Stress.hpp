@@ -0,0 +1,55 @@
+// Stress.hpp
+
+#ifndef SRC_LIB_STRESS_HPP_
+#define SRC_LIB_STRESS_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "MemoryTracker.hpp"
+
+// Area queried from the spatial index every frame, the size of the game window
+constexpr float STRESS_VIEW_WIDTH = 800.0f;
+constexpr float STRESS_VIEW_HEIGHT = 450.0f;
+
+struct StressOptions {
+    unsigned entities = 10000;
+    unsigned frames = 600;
+    float time_step = 1.0f / 60.0f;
+    unsigned workers = 0;  // Zero resolves NODE_MAZE_WORKERS / the hardware concurrency
+    std::string atlas = "resources/characters.json";
+};
+
+struct StressReport {
+    std::string error;  // Set when the run could not start, nothing was measured
+    unsigned entities = 0;
+    unsigned frames = 0;
+    unsigned workers = 0;
+    double seconds = 0.0;
+    double frames_per_second = 0.0;
+    double entities_per_second = 0.0;
+    double p50_ms = 0.0;
+    double p99_ms = 0.0;
+    double max_ms = 0.0;
+    double heap_allocations_per_frame = 0.0;  // operator new calls after the first frame
+    double ecs_allocations_per_frame = 0.0;   // flecs allocations, zero unless installEcsMemoryHooks() ran
+    size_t visible_entities = 0;              // Spatial index query of STRESS_VIEW in the last frame
+    size_t peak_rss_bytes = 0;
+    uint64_t last_frame_hash = 0;  // Draw list of the last frame, see HeadlessBackend::frameHash
+    std::vector<MemoryStats> memory;  // Per subsystem, taken after the last frame
+};
+
+// Reads `--stress [--entities N] [--frames M] [--workers W]`. Returns whether --stress was given,
+// `error` is filled when one of the values is invalid. W is clamped to MAX_WORKERS.
+bool parseStressOptions(int argc, char** argv, StressOptions* options, std::string* error);
+
+// Spawns the entities with Render and Animation components from the atlas and runs the full frame
+// pipeline (spatial index job, simulation, render system) with a headless backend and a fixed step
+StressReport runStress(const StressOptions& options);
+
+void printStressReport(std::ostream& out, const StressReport& report);
+
+#endif  // SRC_LIB_STRESS_HPP_
@@ -0,0 +1,23 @@
+// Workers.cpp
+
+#include "Workers.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <thread>
+
+unsigned resolveWorkerCount(const char* requested) {
+    unsigned hardware = std::max(1u, std::thread::hardware_concurrency());
+
+    if (requested == nullptr || *requested == '\0') {
+        return std::min(hardware, MAX_WORKERS);
+    }
+
+    char* end = nullptr;
+    long value = std::strtol(requested, &end, 10);
+    if (*end != '\0' || value < 1) {
+        return std::min(hardware, MAX_WORKERS);
+    }
+
+    return static_cast<unsigned>(std::min<long>(value, MAX_WORKERS));
+}
@@ -0,0 +1,16 @@
+// Workers.hpp
+
+#ifndef SRC_LIB_WORKERS_HPP_
+#define SRC_LIB_WORKERS_HPP_
+
+#include <cstdint>
+
+// Environment variable read by the game to override the flecs worker count
+constexpr const char* WORKERS_ENV = "NODE_MAZE_WORKERS";
+constexpr unsigned MAX_WORKERS = 64;
+
+// Parses a worker count such as the value of NODE_MAZE_WORKERS. Null, empty or invalid values
+// fall back to the hardware concurrency; the result is always within [1, MAX_WORKERS].
+unsigned resolveWorkerCount(const char* requested);
+
+#endif  // SRC_LIB_WORKERS_HPP_
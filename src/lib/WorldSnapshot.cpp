@@ -0,0 +1,403 @@
+// WorldSnapshot.cpp
+
+#include "WorldSnapshot.hpp"
+
+#include <cstring>
+#include <fstream>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "MappedFile.hpp"
+#include "Profiler.hpp"
+#include "Spawner.hpp"
+
+static const char SNAPSHOT_MAGIC[4] = {'N', 'M', 'W', 'S'};
+static const uint32_t BYTE_ORDER_MARK = 0x01020304;
+static const size_t BLOCK_ALIGNMENT = 64;
+
+enum SnapshotBlockType : uint32_t {
+    BLOCK_ENTITIES = 1,
+    BLOCK_RENDER,
+    BLOCK_ANIMATION,
+    BLOCK_STRINGS,
+    BLOCK_QUADTREE_NODES,
+    BLOCK_QUADTREE_BOUNDS,
+    BLOCK_PATH_INFO,
+    BLOCK_PATH_GRAPH,
+    BLOCK_PATH_NEXT,
+    BLOCK_PATH_IDS,
+    BLOCK_USER_DATA
+};
+
+struct SnapshotHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t byte_order;
+    uint32_t block_count;
+    float world_time;  // Animation timestamps are relative to it
+    uint32_t reserved[3];
+};
+
+struct SnapshotBlock {
+    uint32_t type;
+    uint32_t element_size;  // Catches layout changes of the stored structs
+    uint64_t offset;
+    uint64_t count;
+};
+
+// Animation without the std::string, the name lives in the BLOCK_STRINGS pool
+struct AnimationRecord {
+    uint64_t name_offset;
+    uint32_t name_length;
+    uint32_t actual_frame;
+    uint32_t total_frames;
+    float current_frame;
+    float synced_at;
+    uint32_t reserved;
+};
+
+struct TreeBounds {
+    float lowest_x;
+    float lowest_y;
+    float highest_x;
+    float highest_y;
+};
+
+struct PathInfo {
+    uint32_t size;
+    uint32_t last_key;
+};
+
+struct PathId {
+    uint32_t node;
+    uint32_t key;
+};
+
+static_assert(std::is_trivially_copyable_v<Render>, "Render is written as raw bytes");
+static_assert(std::is_trivially_copyable_v<Node>, "QuadTree nodes are written as raw bytes");
+
+struct PendingBlock {
+    uint32_t type;
+    uint32_t element_size;
+    uint64_t count;
+    std::vector<uint8_t> bytes;
+};
+
+template <typename T>
+static void append(PendingBlock* block, const T* values, size_t count) {
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(values);
+    block->bytes.insert(block->bytes.end(), bytes, bytes + count * sizeof(T));
+    block->count += count;
+}
+
+template <typename T>
+static PendingBlock makeBlock(uint32_t type, const T* values = nullptr, size_t count = 0) {
+    PendingBlock block{type, static_cast<uint32_t>(sizeof(T)), 0, {}};
+    append(&block, values, count);
+    return block;
+}
+
+static uint64_t alignOffset(uint64_t offset) {
+    return (offset + BLOCK_ALIGNMENT - 1) / BLOCK_ALIGNMENT * BLOCK_ALIGNMENT;
+}
+
+// Entities a snapshot covers, the same set is written by save() and replaced by load(). Prefabs are
+// not matched, Render-only entities are not part of a snapshot.
+static flecs::query<const Render, const Animation> snapshotQuery(flecs::world* ecs) {
+    return ecs->query<const Render, const Animation>();
+}
+
+bool WorldSnapshot::save(const std::string& path, flecs::world* ecs, const QuadTree* tree,
+                         const FloydWarshal* paths, std::span<const uint8_t> user_data, std::string* error) {
+    PROFILE_ZONE("WorldSnapshot::save");
+    std::vector<PendingBlock> blocks;
+    blocks.reserve(BLOCK_USER_DATA);  // One per type, the references below stay valid
+    blocks.push_back(makeBlock<uint64_t>(BLOCK_ENTITIES));
+    blocks.push_back(makeBlock<Render>(BLOCK_RENDER));
+    blocks.push_back(makeBlock<AnimationRecord>(BLOCK_ANIMATION));
+    blocks.push_back(makeBlock<char>(BLOCK_STRINGS));
+    PendingBlock& entities = blocks[0];
+    PendingBlock& renders = blocks[1];
+    PendingBlock& animations = blocks[2];
+    PendingBlock& strings = blocks[3];
+
+    // Columns are copied table by table, one contiguous range each
+    auto query = snapshotQuery(ecs);
+    query.run([&](flecs::iter& it) {
+        while (it.next()) {
+            auto render = it.field<const Render>(0);
+            auto animation = it.field<const Animation>(1);
+            append(&renders, &render[0], it.count());
+            for (auto i : it) {
+                uint64_t id = it.entity(i).id();
+                append(&entities, &id, 1);
+
+                const Animation& state = animation[i];
+                AnimationRecord record = {
+                    strings.count, static_cast<uint32_t>(state.name.size()), state.actual_frame,
+                    state.total_frames, state.current_frame, state.synced_at, 0 };
+                append(&animations, &record, 1);
+                append(&strings, state.name.data(), state.name.size());
+            }
+        }
+    });
+
+    if (tree != nullptr) {
+        blocks.push_back(makeBlock(BLOCK_QUADTREE_NODES, tree->arrayList.data(), tree->arrayList.size()));
+        TreeBounds bounds = {tree->lowestX, tree->lowestY, tree->highestX, tree->highestY};
+        blocks.push_back(makeBlock(BLOCK_QUADTREE_BOUNDS, &bounds, 1));
+    }
+
+    if (paths != nullptr) {
+        PathInfo info = {paths->size, paths->last_key};
+        blocks.push_back(makeBlock(BLOCK_PATH_INFO, &info, 1));
+        PendingBlock graph = makeBlock<unsigned>(BLOCK_PATH_GRAPH);
+        PendingBlock next = makeBlock<unsigned>(BLOCK_PATH_NEXT);
+        for (unsigned row = 0; row < paths->size; ++row) {
+            append(&graph, paths->graph[row].data(), paths->size);
+            append(&next, paths->path[row].data(), paths->size);
+        }
+        blocks.push_back(std::move(graph));
+        blocks.push_back(std::move(next));
+        PendingBlock ids = makeBlock<PathId>(BLOCK_PATH_IDS);
+        for (const auto& [node, key] : paths->ids) {
+            PathId id = {node, key};
+            append(&ids, &id, 1);
+        }
+        blocks.push_back(std::move(ids));
+    }
+
+    if (!user_data.empty()) {
+        blocks.push_back(makeBlock(BLOCK_USER_DATA, user_data.data(), user_data.size()));
+    }
+
+    SnapshotHeader header = {};
+    std::memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+    header.version = SNAPSHOT_VERSION;
+    header.byte_order = BYTE_ORDER_MARK;
+    header.block_count = static_cast<uint32_t>(blocks.size());
+    header.world_time = ecs->get_info()->world_time_total;
+
+    std::vector<SnapshotBlock> directory;
+    uint64_t offset = sizeof(SnapshotHeader) + blocks.size() * sizeof(SnapshotBlock);
+    for (const auto& block : blocks) {
+        offset = alignOffset(offset);
+        directory.push_back({block.type, block.element_size, offset, block.count});
+        offset += block.bytes.size();
+    }
+
+    std::ofstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        *error = "Could not write snapshot: " + path;
+        return false;
+    }
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(directory.data()), directory.size() * sizeof(SnapshotBlock));
+
+    static const char PADDING[BLOCK_ALIGNMENT] = {};
+    uint64_t written = sizeof(SnapshotHeader) + directory.size() * sizeof(SnapshotBlock);
+    for (size_t i = 0; i < blocks.size(); ++i) {
+        file.write(PADDING, static_cast<std::streamsize>(directory[i].offset - written));
+        file.write(reinterpret_cast<const char*>(blocks[i].bytes.data()), blocks[i].bytes.size());
+        written = directory[i].offset + blocks[i].bytes.size();
+    }
+
+    if (!file.good()) {
+        *error = "Could not write snapshot: " + path;
+        return false;
+    }
+    return true;
+}
+
+// Typed views of the blocks of a mapped snapshot, validated once when opened
+class SnapshotReader {
+ public:
+    bool open(const MappedFile& file, std::string* error) {
+        data_ = file.data();
+        if (file.size() < sizeof(SnapshotHeader)) {
+            *error = "Not a world snapshot";
+            return false;
+        }
+        std::memcpy(&header_, data_, sizeof(header_));
+        if (std::memcmp(header_.magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC)) != 0) {
+            *error = "Not a world snapshot";
+            return false;
+        }
+        if (header_.version != SNAPSHOT_VERSION || header_.byte_order != BYTE_ORDER_MARK) {
+            *error = "Unsupported snapshot version or byte order";
+            return false;
+        }
+
+        uint64_t directory_end = sizeof(SnapshotHeader) + uint64_t{header_.block_count} * sizeof(SnapshotBlock);
+        if (directory_end > file.size()) {
+            *error = "Truncated snapshot";
+            return false;
+        }
+        blocks_.resize(header_.block_count);
+        std::memcpy(blocks_.data(), data_ + sizeof(SnapshotHeader), blocks_.size() * sizeof(SnapshotBlock));
+        for (const auto& block : blocks_) {
+            if (block.offset % BLOCK_ALIGNMENT != 0 || block.offset > file.size() ||
+                (block.element_size != 0 && block.count > (file.size() - block.offset) / block.element_size)) {
+                *error = "Truncated snapshot";
+                return false;
+            }
+        }
+        return true;
+    }
+
+    float worldTime() const { return header_.world_time; }
+
+    // Null with a zero count when the block is missing or was written with another layout of T
+    template <typename T>
+    const T* block(uint32_t type, size_t* count) const {
+        *count = 0;
+        for (const auto& block : blocks_) {
+            if (block.type != type || block.element_size != sizeof(T)) continue;
+            *count = static_cast<size_t>(block.count);
+            return reinterpret_cast<const T*>(data_ + block.offset);
+        }
+        return nullptr;
+    }
+
+ private:
+    const uint8_t* data_ = nullptr;
+    SnapshotHeader header_{};
+    std::vector<SnapshotBlock> blocks_;
+};
+
+bool WorldSnapshot::load(const std::string& path, flecs::world* ecs, QuadTree* tree, FloydWarshal* paths,
+                         std::span<uint8_t> user_data, std::string* error) {
+    PROFILE_ZONE("WorldSnapshot::load");
+    MappedFile file;
+    if (!file.open(path)) {
+        *error = "Could not open snapshot: " + path;
+        return false;
+    }
+    SnapshotReader reader;
+    if (!reader.open(file, error)) {
+        *error += ": " + path;
+        return false;
+    }
+
+    size_t entity_count = 0;
+    size_t render_count = 0;
+    size_t animation_count = 0;
+    size_t string_count = 0;
+    const uint64_t* saved_ids = reader.block<uint64_t>(BLOCK_ENTITIES, &entity_count);
+    const Render* renders = reader.block<Render>(BLOCK_RENDER, &render_count);
+    const AnimationRecord* records = reader.block<AnimationRecord>(BLOCK_ANIMATION, &animation_count);
+    const char* strings = reader.block<char>(BLOCK_STRINGS, &string_count);
+    if (render_count != entity_count || animation_count != entity_count) {
+        *error = "Inconsistent entity blocks in snapshot: " + path;
+        return false;
+    }
+
+    // Timestamps move to the time line of the loading world, a snapshot can be loaded at any time
+    float time_shift = ecs->get_info()->world_time_total - reader.worldTime();
+    std::vector<Animation> animations(entity_count);
+    for (size_t i = 0; i < entity_count; ++i) {
+        const AnimationRecord& record = records[i];
+        if (record.name_offset > string_count || record.name_length > string_count - record.name_offset) {
+            *error = "Corrupted animation names in snapshot: " + path;
+            return false;
+        }
+        animations[i].name.assign(strings + record.name_offset, record.name_length);
+        animations[i].actual_frame = record.actual_frame;
+        animations[i].total_frames = record.total_frames;
+        animations[i].current_frame = record.current_frame;
+        animations[i].synced_at = record.synced_at < 0.0f ? record.synced_at : record.synced_at + time_shift;
+    }
+
+    // Everything is validated before the world is touched
+    size_t node_count = 0;
+    size_t bounds_count = 0;
+    const Node* nodes = reader.block<Node>(BLOCK_QUADTREE_NODES, &node_count);
+    const TreeBounds* bounds = reader.block<TreeBounds>(BLOCK_QUADTREE_BOUNDS, &bounds_count);
+    for (size_t i = 0; i < node_count; ++i) {
+        const Node& node = nodes[i];
+        if (node.divided && (node.nw >= node_count || node.ne >= node_count ||
+                             node.sw >= node_count || node.se >= node_count)) {
+            *error = "Corrupted QuadTree in snapshot: " + path;
+            return false;
+        }
+    }
+
+    size_t info_count = 0;
+    size_t graph_count = 0;
+    size_t next_count = 0;
+    size_t id_count = 0;
+    const PathInfo* info = reader.block<PathInfo>(BLOCK_PATH_INFO, &info_count);
+    const unsigned* graph = reader.block<unsigned>(BLOCK_PATH_GRAPH, &graph_count);
+    const unsigned* next = reader.block<unsigned>(BLOCK_PATH_NEXT, &next_count);
+    const PathId* ids = reader.block<PathId>(BLOCK_PATH_IDS, &id_count);
+    if (info_count == 1 && (graph_count != size_t{info->size} * info->size || next_count != graph_count)) {
+        *error = "Inconsistent path blocks in snapshot: " + path;
+        return false;
+    }
+
+    size_t user_count = 0;
+    const uint8_t* saved_user_data = reader.block<uint8_t>(BLOCK_USER_DATA, &user_count);
+    if (!user_data.empty() && user_count != user_data.size()) {
+        *error = "Missing or mismatched user data in snapshot: " + path;
+        return false;
+    }
+
+    std::vector<flecs::entity_t> replaced;
+    snapshotQuery(ecs).each([&replaced](flecs::entity entity, const Render&, const Animation&) {
+        replaced.push_back(entity.id());
+    });
+    ecs->defer_begin();
+    for (flecs::entity_t entity : replaced) {
+        ecs->entity(entity).destruct();
+    }
+    ecs->defer_end();
+
+    Spawner spawner(ecs);
+    std::vector<flecs::entity_t> spawned = spawner.spawn(
+        std::span<const Render>(renders, render_count), std::move(animations));
+
+    if (tree != nullptr && node_count > 0 && bounds_count == 1) {
+        // The tree stores the low 32 bits of the entity ids, those of the new entities replace them
+        std::unordered_map<uint32_t, uint32_t> remap;
+        remap.reserve(entity_count);
+        for (size_t i = 0; i < entity_count; ++i) {
+            remap[static_cast<uint32_t>(saved_ids[i])] = static_cast<uint32_t>(spawned[i]);
+        }
+
+        tree->arrayList.assign(nodes, nodes + node_count);
+        for (Node& node : tree->arrayList) {
+            for (uint32_t i = 0; i < node.total_elements && i < node.points.size(); ++i) {
+                auto found = remap.find(node.points[i].entity);
+                if (found != remap.end()) {
+                    node.points[i].entity = found->second;
+                }
+            }
+        }
+        tree->lowestX = bounds->lowest_x;
+        tree->lowestY = bounds->lowest_y;
+        tree->highestX = bounds->highest_x;
+        tree->highestY = bounds->highest_y;
+    }
+
+    if (!user_data.empty()) {
+        std::memcpy(user_data.data(), saved_user_data, user_data.size());
+    }
+
+    if (paths != nullptr && info_count == 1) {
+        paths->size = info->size;
+        paths->last_key = info->last_key;
+        paths->graph.resize(info->size);
+        paths->path.resize(info->size);
+        for (unsigned row = 0; row < info->size; ++row) {
+            paths->graph[row].assign(graph + size_t{row} * info->size, graph + size_t{row + 1} * info->size);
+            paths->path[row].assign(next + size_t{row} * info->size, next + size_t{row + 1} * info->size);
+        }
+        paths->ids.clear();
+        for (size_t i = 0; i < id_count; ++i) {
+            paths->ids[ids[i].node] = ids[i].key;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,40 @@
+// WorldSnapshot.hpp
+
+#ifndef SRC_LIB_WORLDSNAPSHOT_HPP_
+#define SRC_LIB_WORLDSNAPSHOT_HPP_
+
+#include <cstdint>
+#include <span>
+#include <string>
+
+#include "../Components.hpp"
+#include "FloydWarshal.hpp"
+#include "QuadTree.hpp"
+#include "flecs.h"
+
+// Snapshot layout, native byte order (checked on load):
+//   header      "NMWS", version, byte order mark, block count, world time
+//   directory   one entry per block: type, element size, offset, element count
+//   blocks      typed arrays aligned to 64 bytes, used in place from the mapped file
+constexpr uint32_t SNAPSHOT_VERSION = 1;
+
+// Saves and restores the Render / Animation columns, the derived structures of a level and an opaque
+// block of application state. Loading
+// maps the file and hands the Render block straight to a bulk spawn, the only fix-ups are the
+// Animation names, the animation timestamps and the entity ids stored in the QuadTree.
+class WorldSnapshot {
+ public:
+    // Every entity with Render and Animation except prefabs, plus the tree and the path matrices when
+    // not null and `user_data` when not empty
+    static bool save(const std::string& path, flecs::world* ecs, const QuadTree* tree,
+                     const FloydWarshal* paths, std::span<const uint8_t> user_data, std::string* error);
+
+    // Replaces the entities save() would write by the saved ones, other entities and prefabs are
+    // kept. `tree` and `paths` are restored when not null and present in the snapshot, they are
+    // left untouched otherwise. A non empty `user_data` is filled from the snapshot, which fails
+    // without touching the world when its user data has another size.
+    static bool load(const std::string& path, flecs::world* ecs, QuadTree* tree, FloydWarshal* paths,
+                     std::span<uint8_t> user_data, std::string* error);
+};
+
+#endif  // SRC_LIB_WORLDSNAPSHOT_HPP_
@@ -0,0 +1,31 @@
+// AllocationCounterTest.cpp
+
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch_all.hpp>
+
+#include <memory>
+#include <vector>
+
+#include "AllocationCounter.hpp"
+
+TEST_CASE("Heap allocations are counted", "[AllocationCounter]") {
+    uint64_t before = heapAllocations();
+
+    auto value = std::make_unique<int>(1);
+    std::vector<int> values(100);
+
+    REQUIRE(heapAllocations() - before == 2);
+}
+
+TEST_CASE("Reusing capacity does not count as an allocation", "[AllocationCounter]") {
+    std::vector<int> values;
+    values.reserve(100);
+
+    uint64_t before = heapAllocations();
+    for (int i = 0; i < 100; ++i) {
+        values.push_back(i);
+    }
+    values.clear();
+
+    REQUIRE(heapAllocations() == before);
+}
@@ -3,6 +3,7 @@
 
 #include <catch2/catch_all.hpp>
 #include "FloydWarshal.hpp"
+#include "JobSystem.hpp"
 
 TEST_CASE("Floyd-Warshall generates a connection between two points", "[generate_connection]") {
     FloydWarshal fw(3);
@@ -65,3 +66,33 @@ TEST_CASE("Floyd-Warshall resizes correctly", "[resize]") {
     fw.generate();
     REQUIRE(fw.hasPath(1, 3));
 }
+
+TEST_CASE("Floyd-Warshall generates the same paths with a job system", "[generate][parallel]") {
+    const unsigned SIZE = 64;
+    FloydWarshal serial(SIZE);
+    FloydWarshal parallel(SIZE);
+    serial.clean();
+    parallel.clean();
+
+    for (unsigned i = 0; i < SIZE; ++i) {
+        unsigned w = (i * 7) % 5 + 1;
+        serial.addEdge(i, (i + 1) % SIZE, w);
+        parallel.addEdge(i, (i + 1) % SIZE, w);
+        unsigned shortcut = (i * 13 + 5) % SIZE;
+        if (shortcut != i) {
+            serial.addEdge(i, shortcut, w + 2);
+            parallel.addEdge(i, shortcut, w + 2);
+        }
+    }
+
+    JobSystem jobs(4);
+    serial.generate();
+    parallel.generate(jobs);
+
+    for (unsigned i = 0; i < SIZE; ++i) {
+        for (unsigned j = 0; j < SIZE; ++j) {
+            REQUIRE(serial.value(i, j) == parallel.value(i, j));
+            REQUIRE(serial.next(i, j) == parallel.next(i, j));
+        }
+    }
+}
@@ -0,0 +1,87 @@
+// FrameArenaTest.cpp
+
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch_all.hpp>
+
+#include <cstdint>
+#include <memory_resource>
+#include <thread>
+#include <vector>
+
+#include "FrameArena.hpp"
+
+TEST_CASE("Frame arena returns aligned, non overlapping blocks", "[FrameArena]") {
+    FrameArena arena(1024);
+
+    void* first = arena.allocate(3, 1);
+    void* second = arena.allocate(16, 16);
+    void* third = arena.allocate(8, 8);
+
+    REQUIRE(reinterpret_cast<uintptr_t>(second) % 16 == 0);
+    REQUIRE(reinterpret_cast<uintptr_t>(third) % 8 == 0);
+    REQUIRE(static_cast<char*>(second) >= static_cast<char*>(first) + 3);
+    REQUIRE(static_cast<char*>(third) >= static_cast<char*>(second) + 16);
+    REQUIRE(arena.used() == 27);
+}
+
+TEST_CASE("Frame arena reuses its memory after a reset", "[FrameArena]") {
+    FrameArena arena(1024);
+
+    void* before = arena.allocate(64, 8);
+    arena.reset();
+    void* after = arena.allocate(64, 8);
+
+    REQUIRE(before == after);
+    REQUIRE(arena.used() == 64);
+    REQUIRE(arena.peak() == 64);
+}
+
+TEST_CASE("Frame arena merges overflow chunks on reset", "[FrameArena]") {
+    FrameArena arena(128);
+
+    for (int i = 0; i < 10; ++i) {
+        REQUIRE(arena.allocate(100, 8) != nullptr);
+    }
+    REQUIRE(arena.chunkCount() > 1);
+    size_t grown = arena.capacity();
+
+    // The next frame with the same allocations fits in a single chunk
+    arena.reset();
+    REQUIRE(arena.chunkCount() == 1);
+    REQUIRE(arena.capacity() == grown);
+    for (int i = 0; i < 10; ++i) {
+        REQUIRE(arena.allocate(100, 8) != nullptr);
+    }
+    REQUIRE(arena.chunkCount() == 1);
+}
+
+TEST_CASE("Frame arena backs pmr containers", "[FrameArena][pmr]") {
+    FrameArena arena;
+    std::pmr::vector<int> values(&arena);
+
+    for (int i = 0; i < 1000; ++i) {
+        values.push_back(i);
+    }
+
+    REQUIRE(values.size() == 1000);
+    REQUIRE(values[999] == 999);
+    REQUIRE(arena.used() >= 1000 * sizeof(int));
+}
+
+TEST_CASE("Every thread gets its own frame arena", "[FrameArena][threads]") {
+    FrameArena* main_arena = &FrameArena::local();
+    FrameArena* worker_arena = nullptr;
+
+    std::thread worker([&worker_arena]() {
+        worker_arena = &FrameArena::local();
+        REQUIRE(worker_arena->allocate(32, 8) != nullptr);
+    });
+    worker.join();
+
+    REQUIRE(main_arena == &FrameArena::local());
+    REQUIRE(worker_arena != main_arena);
+
+    REQUIRE(main_arena->allocate(32, 8) != nullptr);
+    FrameArena::resetAll();
+    REQUIRE(main_arena->used() == 0);
+}
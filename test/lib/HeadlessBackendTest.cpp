@@ -0,0 +1,86 @@
+// HeadlessBackendTest.cpp
+
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch_all.hpp>
+
+#include "HeadlessBackend.hpp"
+
+static void drawScene(IRenderBackend* backend, float x) {
+    Texture2D texture = backend->loadTexture("characters.png");
+    backend->beginFrame();
+    backend->clear(RAYWHITE);
+    backend->drawTexture(texture, {0.0f, 0.0f, 16.0f, 16.0f}, {x, 10.0f, 16.0f, 16.0f}, {0.0f, 0.0f}, 0.0f, WHITE);
+    backend->drawText("Move the ball with arrow keys", 10, 10, 20, DARKGRAY);
+    backend->drawCircle({x, 20.0f}, 5.0f, MAROON);
+    backend->endFrame();
+}
+
+TEST_CASE("Headless backend records the draw calls of a frame", "[HeadlessBackend]") {
+    HeadlessBackend backend;
+    drawScene(&backend, 40.0f);
+
+    const auto& commands = backend.commands();
+    REQUIRE(commands.size() == 4);
+    REQUIRE(commands[0].op == DrawOp::CLEAR);
+    REQUIRE(commands[1].op == DrawOp::TEXTURE);
+    REQUIRE(commands[1].resource == 1);
+    REQUIRE(commands[1].dest.x == 40.0f);
+    REQUIRE(commands[2].op == DrawOp::TEXT);
+    REQUIRE(backend.text(commands[2]) == "Move the ball with arrow keys");
+    REQUIRE(commands[3].op == DrawOp::CIRCLE);
+    REQUIRE(commands[3].dest.width == 5.0f);
+    REQUIRE(backend.framesRecorded() == 1);
+}
+
+TEST_CASE("Headless backend starts a new command buffer every frame", "[HeadlessBackend]") {
+    HeadlessBackend backend;
+    drawScene(&backend, 40.0f);
+    drawScene(&backend, 40.0f);
+
+    REQUIRE(backend.commands().size() == 4);
+    REQUIRE(backend.framesRecorded() == 2);
+}
+
+TEST_CASE("Frame hash only depends on the draw list", "[HeadlessBackend][hash]") {
+    HeadlessBackend first;
+    HeadlessBackend same;
+    HeadlessBackend moved;
+    drawScene(&first, 40.0f);
+    drawScene(&same, 40.0f);
+    drawScene(&moved, 41.0f);
+
+    REQUIRE(first.frameHash() == same.frameHash());
+    REQUIRE(first.frameHash() != moved.frameHash());
+}
+
+TEST_CASE("Replaying a frame reproduces the same draw list", "[HeadlessBackend][replay]") {
+    HeadlessBackend recorded;
+    HeadlessBackend target;
+    drawScene(&recorded, 40.0f);
+
+    recorded.replay(&target);
+
+    REQUIRE(target.commands().size() == recorded.commands().size());
+    REQUIRE(target.frameHash() == recorded.frameHash());
+}
+
+TEST_CASE("Unloaded headless textures free their id", "[HeadlessBackend]") {
+    HeadlessBackend backend;
+    Texture2D characters = backend.loadTexture("characters.png");
+    Texture2D tiles = backend.loadTexture("tiles.png");
+    REQUIRE(characters.id == 1);
+    REQUIRE(tiles.id == 2);
+    REQUIRE(backend.texturePath(tiles.id) == "tiles.png");
+
+    // Reloading, as Renderer::LoadTextures does, does not grow the texture table
+    for (int i = 0; i < 10; ++i) {
+        backend.unloadTexture(characters);
+        characters = backend.loadTexture("characters.png");
+    }
+    REQUIRE(characters.id == 1);
+    REQUIRE(backend.loadedTextures() == 2);
+
+    backend.unloadTexture(tiles);
+    REQUIRE(backend.loadedTextures() == 1);
+    REQUIRE(backend.texturePath(tiles.id).empty());
+}
@@ -0,0 +1,171 @@
+// InputLogTest.cpp
+
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch_all.hpp>
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "InputLog.hpp"
+
+// Hands out a fixed list of key states
+class ScriptedInput : public IInputSource {
+ public:
+    ScriptedInput(std::vector<uint8_t> keys, float step) : keys_(std::move(keys)), step_(step) {}
+
+    bool poll(FrameInput* input) override {
+        if (next_ >= keys_.size()) return false;
+        input->keys = keys_[next_++];
+        input->delta_time = step_;
+        return true;
+    }
+
+ private:
+    std::vector<uint8_t> keys_;
+    float step_;
+    size_t next_ = 0;
+};
+
+static std::string logPath(const char* name) {
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+
+TEST_CASE("Input log replays the recorded keys with the fixed step", "[InputLog]") {
+    std::vector<uint8_t> keys = {0, 0, INPUT_RIGHT, INPUT_RIGHT | INPUT_UP, INPUT_RIGHT, 0, INPUT_DOWN};
+    std::string path = logPath("node_maze_round_trip.nmil");
+    {
+        ScriptedInput source(keys, 1.0f / 120.0f);
+        InputRecorder recorder(&source, path, 1.0f / 120.0f);
+        FrameInput input;
+        while (recorder.poll(&input)) {}
+        REQUIRE(recorder.frames() == keys.size());
+        REQUIRE(recorder.good());
+    }
+
+    InputReplay replay;
+    std::string error;
+    REQUIRE(replay.load(path, &error));
+    REQUIRE(replay.step() == 1.0f / 120.0f);
+    REQUIRE(replay.frameCount() == keys.size());
+
+    FrameInput input;
+    for (uint8_t expected : keys) {
+        REQUIRE(replay.poll(&input));
+        REQUIRE(input.keys == expected);
+        REQUIRE(input.delta_time == 1.0f / 120.0f);
+    }
+    REQUIRE_FALSE(replay.poll(&input));
+}
+
+TEST_CASE("Input log stores held keys as runs", "[InputLog]") {
+    std::string path = logPath("node_maze_runs.nmil");
+    {
+        ScriptedInput source(std::vector<uint8_t>(10000, INPUT_LEFT), 1.0f / 60.0f);
+        InputRecorder recorder(&source, path, 1.0f / 60.0f);
+        FrameInput input;
+        while (recorder.poll(&input)) {}
+    }
+
+    // Header plus a single run record
+    REQUIRE(std::filesystem::file_size(path) < 32);
+
+    InputReplay replay;
+    std::string error;
+    REQUIRE(replay.load(path, &error));
+    REQUIRE(replay.frameCount() == 10000);
+}
+
+TEST_CASE("Input log keeps the world hash checkpoints", "[InputLog]") {
+    std::string path = logPath("node_maze_checkpoints.nmil");
+    {
+        ScriptedInput source({INPUT_UP, INPUT_UP, INPUT_UP, 0}, 0.5f);
+        InputRecorder recorder(&source, path, 0.5f);
+        FrameInput input;
+        recorder.poll(&input);
+        recorder.checkpoint(0x1234);
+        recorder.poll(&input);
+        recorder.poll(&input);
+        recorder.checkpoint(0xFEDCBA9876543210ull);
+        recorder.poll(&input);
+    }
+
+    InputReplay replay;
+    std::string error;
+    REQUIRE(replay.load(path, &error));
+    REQUIRE(replay.checkpointCount() == 2);
+
+    uint64_t hash = 0;
+    REQUIRE(replay.checkpoint(0, &hash));
+    REQUIRE(hash == 0x1234);
+    REQUIRE_FALSE(replay.checkpoint(1, &hash));
+    REQUIRE(replay.checkpoint(2, &hash));
+    REQUIRE(hash == 0xFEDCBA9876543210ull);
+}
+
+TEST_CASE("Input log rejects files that are not logs", "[InputLog]") {
+    std::string path = logPath("node_maze_not_a_log.nmil");
+    std::ofstream(path) << "{\"frames\": []}";
+
+    InputReplay replay;
+    std::string error;
+    REQUIRE_FALSE(replay.load(path, &error));
+    REQUIRE_FALSE(error.empty());
+
+    error.clear();
+    REQUIRE_FALSE(replay.load(logPath("node_maze_missing.nmil"), &error));
+    REQUIRE_FALSE(error.empty());
+}
+
+TEST_CASE("Input log rejects runs beyond the frame count of the header", "[InputLog]") {
+    std::string path = logPath("node_maze_long_run.nmil");
+    {
+        ScriptedInput source({INPUT_UP, INPUT_UP, 0}, 0.5f);
+        InputRecorder recorder(&source, path, 0.5f);
+        FrameInput input;
+        while (recorder.poll(&input)) {}
+    }
+    // A run record claiming about four billion frames
+    {
+        std::ofstream file(path, std::ios::binary | std::ios::app);
+        const char run[] = {0x01, 0x00, '\xFF', '\xFF', '\xFF', '\xFF', 0x0F};
+        file.write(run, sizeof(run));
+    }
+
+    InputReplay replay;
+    std::string error;
+    REQUIRE_FALSE(replay.load(path, &error));
+    REQUIRE(error.find("Corrupted") != std::string::npos);
+}
+
+TEST_CASE("Input log reports a truncated header", "[InputLog]") {
+    std::string path = logPath("node_maze_short_header.nmil");
+    {
+        std::ofstream file(path, std::ios::binary);
+        const char header[] = {'N', 'M', 'I', 'L', 0x02, 0x00, 0x00, 0x00, 0x00, 0x00};
+        file.write(header, sizeof(header));
+    }
+
+    InputReplay replay;
+    std::string error;
+    REQUIRE_FALSE(replay.load(path, &error));
+    REQUIRE(error.find("Truncated") != std::string::npos);
+}
+
+TEST_CASE("Input log reports a record cut off at the end", "[InputLog]") {
+    std::string path = logPath("node_maze_cut_run.nmil");
+    {
+        ScriptedInput source(std::vector<uint8_t>(200, INPUT_LEFT), 0.5f);
+        InputRecorder recorder(&source, path, 0.5f);
+        FrameInput input;
+        while (recorder.poll(&input)) {}
+    }
+    // The last record is the 200 frame run, its varint takes two bytes
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 1);
+
+    InputReplay replay;
+    std::string error;
+    REQUIRE_FALSE(replay.load(path, &error));
+    REQUIRE(error.find("Truncated") != std::string::npos);
+}
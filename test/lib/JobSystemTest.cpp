@@ -0,0 +1,113 @@
+// JobSystemTest.cpp
+
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch_all.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <numeric>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "AllocationCounter.hpp"
+#include "JobSystem.hpp"
+
+TEST_CASE("Submitted jobs run to completion", "[JobSystem]") {
+    JobSystem jobs(4);
+    std::atomic<int> counter{0};
+
+    std::vector<JobHandle> handles;
+    for (int i = 0; i < 1000; ++i) {
+        handles.push_back(jobs.submit([&counter]() { counter.fetch_add(1); }));
+    }
+    jobs.wait(handles);
+
+    REQUIRE(counter.load() == 1000);
+}
+
+TEST_CASE("Jobs only run after their dependencies", "[JobSystem][graph]") {
+    JobSystem jobs(4);
+    std::mutex mutex;
+    std::vector<int> order;
+    auto record = [&](int value) {
+        return [&, value]() {
+            std::lock_guard<std::mutex> lock(mutex);
+            order.push_back(value);
+        };
+    };
+
+    // 1 -> (2, 3) -> 4
+    JobHandle first = jobs.submit(record(1));
+    JobHandle left = jobs.submit(record(2), {first});
+    JobHandle right = jobs.submit(record(3), {first});
+    JobHandle last = jobs.submit(record(4), {left, right});
+    jobs.wait(last);
+
+    REQUIRE(order.size() == 4);
+    REQUIRE(order.front() == 1);
+    REQUIRE(order.back() == 4);
+}
+
+TEST_CASE("Parallel for covers the whole range exactly once", "[JobSystem][parallel_for]") {
+    JobSystem jobs(3);
+    std::vector<int> values(10007, 0);
+
+    jobs.parallelFor(0, values.size(), 64, [&values](size_t first, size_t last) {
+        for (size_t i = first; i < last; ++i) {
+            values[i] += 1;
+        }
+    });
+
+    REQUIRE(std::accumulate(values.begin(), values.end(), 0) == 10007);
+}
+
+TEST_CASE("Waiting on a failed job rethrows its exception", "[JobSystem]") {
+    JobSystem jobs(2);
+    JobHandle failing = jobs.submit([]() { throw std::runtime_error("job failed"); });
+
+    REQUIRE_THROWS_AS(jobs.wait(failing), std::runtime_error);
+}
+
+TEST_CASE("A failed parallelFor chunk rethrows after every other chunk finished", "[JobSystem]") {
+    JobSystem jobs(4);
+    std::atomic<int> finished{0};
+
+    REQUIRE_THROWS_AS(jobs.parallelFor(0, 64, 1, [&finished](size_t first, size_t) {
+        if (first == 0) throw std::runtime_error("chunk failed");
+        std::this_thread::sleep_for(std::chrono::microseconds(200));
+        finished.fetch_add(1);
+    }), std::runtime_error);
+
+    // Nothing may still run the body once parallelFor returned, it lives on the caller's stack
+    REQUIRE(finished.load() == 63);
+}
+
+TEST_CASE("parallelFor does not allocate in steady state", "[JobSystem][allocations]") {
+    JobSystem jobs(4);
+    std::atomic<size_t> sum{0};
+    std::function<void(size_t, size_t)> body = [&sum](size_t first, size_t last) {
+        sum.fetch_add(last - first);
+    };
+    // Fills the job pool
+    jobs.parallelFor(0, 1024, 64, body);
+
+    const int CALLS = 100;
+    uint64_t before = heapAllocations();
+    for (int call = 0; call < CALLS; ++call) {
+        jobs.parallelFor(0, 1024, 64, body);
+    }
+
+    // Only the queue deques may allocate, when jobs move their window into a new block
+    REQUIRE(heapAllocations() - before < CALLS);
+    REQUIRE(sum.load() == 1024 * (CALLS + 1));
+}
+
+TEST_CASE("An empty handle counts as done", "[JobSystem]") {
+    JobSystem jobs(1);
+    JobHandle empty;
+
+    REQUIRE(empty.done());
+    jobs.wait(empty);
+}
@@ -0,0 +1,134 @@
+// MemoryTrackerTest.cpp
+
+#define CATCH_CONFIG_MAIN
+
+#include <catch2/catch_all.hpp>
+#include <string>
+#include <vector>
+
+#include "FloydWarshal.hpp"
+#include "MemoryTracker.hpp"
+#include "flecs.h"
+
+// Tags shared with the production code are only compared before and after, other tests may hold memory
+
+TEST_CASE("MemoryTracker counts live bytes, peak bytes and allocations", "[memory_counts]") {
+    MemoryStats before = MemoryTracker::stats(MemoryTag::TEXTURES);
+
+    MemoryTracker::allocated(MemoryTag::TEXTURES, 1000);
+    MemoryTracker::allocated(MemoryTag::TEXTURES, 500);
+    MemoryTracker::freed(MemoryTag::TEXTURES, 1000);
+
+    MemoryStats after = MemoryTracker::stats(MemoryTag::TEXTURES);
+    REQUIRE(after.live_bytes == before.live_bytes + 500);
+    REQUIRE(after.peak_bytes >= before.live_bytes + 1500);
+    REQUIRE(after.allocations == before.allocations + 2);
+    REQUIRE(after.frees == before.frees + 1);
+    REQUIRE(std::string(after.name) == "textures");
+
+    MemoryTracker::freed(MemoryTag::TEXTURES, 500);
+    REQUIRE(MemoryTracker::stats(MemoryTag::TEXTURES).live_bytes == before.live_bytes);
+}
+
+TEST_CASE("TrackedAllocator accounts a container to its tag", "[memory_allocator]") {
+    size_t before = MemoryTracker::stats(MemoryTag::SPRITE_MAP).live_bytes;
+    {
+        std::vector<int, TrackedAllocator<int, MemoryTag::SPRITE_MAP>> values;
+        values.reserve(256);
+        REQUIRE(MemoryTracker::stats(MemoryTag::SPRITE_MAP).live_bytes == before + 256 * sizeof(int));
+    }
+    REQUIRE(MemoryTracker::stats(MemoryTag::SPRITE_MAP).live_bytes == before);
+}
+
+TEST_CASE("FloydWarshal matrices are accounted to pathfinding", "[memory_pathfinding]") {
+    size_t before = MemoryTracker::stats(MemoryTag::PATHFINDING).live_bytes;
+    {
+        FloydWarshal fw(64);
+        // Two 64 x 64 matrices at least
+        REQUIRE(MemoryTracker::stats(MemoryTag::PATHFINDING).live_bytes >= before + 2 * 64 * 64 * sizeof(unsigned));
+    }
+    REQUIRE(MemoryTracker::stats(MemoryTag::PATHFINDING).live_bytes == before);
+}
+
+TEST_CASE("Memory budgets flag a subsystem until it is back under budget", "[memory_budget]") {
+    size_t live = MemoryTracker::stats(MemoryTag::TEXTURES).live_bytes;
+    MemoryTracker::setBudget(MemoryTag::TEXTURES, live + 1024);
+    REQUIRE_FALSE(MemoryTracker::overBudget(MemoryTag::TEXTURES));
+
+    MemoryTracker::allocated(MemoryTag::TEXTURES, 2048);
+    REQUIRE(MemoryTracker::overBudget(MemoryTag::TEXTURES));
+    REQUIRE(MemoryTracker::stats(MemoryTag::TEXTURES).budget_bytes == live + 1024);
+
+    MemoryTracker::freed(MemoryTag::TEXTURES, 2048);
+    REQUIRE_FALSE(MemoryTracker::overBudget(MemoryTag::TEXTURES));
+
+    MemoryTracker::setBudget(MemoryTag::TEXTURES, 0);
+    REQUIRE(MemoryTracker::stats(MemoryTag::TEXTURES).budget_bytes == 0);
+}
+
+static unsigned warnings = 0;
+
+static void countWarning(MemoryTag, size_t, size_t) {
+    warnings++;
+}
+
+TEST_CASE("Memory budgets warn once per crossing", "[memory_budget_warning]") {
+    MemoryTracker::setWarningSink(countWarning);
+    warnings = 0;
+    size_t live = MemoryTracker::stats(MemoryTag::TEXTURES).live_bytes;
+    MemoryTracker::setBudget(MemoryTag::TEXTURES, live + 1024);
+
+    // Going over warns, staying over does not
+    MemoryTracker::allocated(MemoryTag::TEXTURES, 2048);
+    MemoryTracker::allocated(MemoryTag::TEXTURES, 2048);
+    REQUIRE(warnings == 1);
+
+    // Still over after a free, no new crossing
+    MemoryTracker::freed(MemoryTag::TEXTURES, 2048);
+    MemoryTracker::allocated(MemoryTag::TEXTURES, 16);
+    REQUIRE(warnings == 1);
+
+    // Back under the budget re-arms the warning
+    MemoryTracker::freed(MemoryTag::TEXTURES, 2064);
+    MemoryTracker::allocated(MemoryTag::TEXTURES, 2048);
+    REQUIRE(warnings == 2);
+
+    MemoryTracker::freed(MemoryTag::TEXTURES, 2048);
+    MemoryTracker::setBudget(MemoryTag::TEXTURES, 0);
+    MemoryTracker::allocated(MemoryTag::TEXTURES, 4096);
+    MemoryTracker::freed(MemoryTag::TEXTURES, 4096);
+    REQUIRE(warnings == 2);
+    MemoryTracker::setWarningSink(nullptr);
+}
+
+TEST_CASE("Memory budgets are read from MiB per tag", "[memory_budget_parse]") {
+    std::string error;
+    REQUIRE(applyMemoryBudgets("pathfinding=2,ecs=0.5", &error));
+    REQUIRE(MemoryTracker::stats(MemoryTag::PATHFINDING).budget_bytes == 2 * 1024 * 1024);
+    REQUIRE(MemoryTracker::stats(MemoryTag::ECS).budget_bytes == 512 * 1024);
+    REQUIRE(applyMemoryBudgets(nullptr, &error));
+
+    REQUIRE_FALSE(applyMemoryBudgets("physics=10", &error));
+    REQUIRE_FALSE(applyMemoryBudgets("ecs=lots", &error));
+    REQUIRE_FALSE(applyMemoryBudgets("ecs=nan", &error));
+    REQUIRE_FALSE(applyMemoryBudgets("ecs=inf", &error));
+    REQUIRE_FALSE(applyMemoryBudgets("ecs=-1", &error));
+    REQUIRE_FALSE(applyMemoryBudgets("ecs=1e300", &error));
+    REQUIRE_FALSE(error.empty());
+
+    // A bad entry leaves the earlier ones of the same text unapplied
+    REQUIRE_FALSE(applyMemoryBudgets("pathfinding=8,ecs=inf", &error));
+    REQUIRE(MemoryTracker::stats(MemoryTag::PATHFINDING).budget_bytes == 2 * 1024 * 1024);
+
+    MemoryTracker::setBudget(MemoryTag::PATHFINDING, 0);
+    MemoryTracker::setBudget(MemoryTag::ECS, 0);
+}
+
+TEST_CASE("ECS memory hooks are refused once flecs is initialized", "[memory_ecs_hooks]") {
+    { flecs::world ecs; }
+    auto* default_free = ecs_os_api.free_;
+
+    // Blocks of the default allocator may still be alive, they must not reach the hooks
+    REQUIRE_FALSE(installEcsMemoryHooks());
+    REQUIRE(ecs_os_api.free_ == default_free);
+}
@@ -0,0 +1,128 @@
+// ProfilerTest.cpp
+
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch_all.hpp>
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <nlohmann/json.hpp>
+
+#include "Profiler.hpp"
+
+static const ZoneStats* findZone(const std::vector<ZoneStats>& stats, const std::string& name) {
+    for (const auto& zone : stats) {
+        if (zone.name == name) return &zone;
+    }
+    return nullptr;
+}
+
+TEST_CASE("Zones are not recorded while the profiler is disabled", "[Profiler]") {
+    Profiler& profiler = Profiler::instance();
+    profiler.setEnabled(false);
+    profiler.clear();
+
+    { PROFILE_ZONE("disabled zone"); }
+    profiler.collect();
+
+    auto stats = profiler.stats();
+    REQUIRE(findZone(stats, "disabled zone") == nullptr);
+}
+
+TEST_CASE("Rings of exited threads are reused", "[Profiler]") {
+    Profiler& profiler = Profiler::instance();
+    profiler.setEnabled(true);
+    profiler.clear();
+
+    // Short lived recording threads, like the workers of JobSystems created and destroyed in turn
+    auto record = []() {
+        std::thread thread([]() { PROFILE_ZONE("short lived zone"); });
+        thread.join();
+    };
+    record();
+    size_t rings = profiler.ringCount();
+    for (int i = 0; i < 50; ++i) {
+        record();
+    }
+    profiler.collect();
+    profiler.setEnabled(false);
+
+    REQUIRE(profiler.ringCount() == rings);
+    auto stats = profiler.stats();
+    const ZoneStats* zone = findZone(stats, "short lived zone");
+    REQUIRE(zone != nullptr);
+    REQUIRE(zone->samples == 51);
+}
+
+TEST_CASE("Zones from every thread are collected", "[Profiler]") {
+    Profiler& profiler = Profiler::instance();
+    profiler.setEnabled(true);
+    profiler.clear();
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([]() {
+            for (int i = 0; i < 10; ++i) {
+                PROFILE_ZONE("worker zone");
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    { PROFILE_ZONE("main zone"); }
+    profiler.collect();
+    profiler.setEnabled(false);
+
+    auto stats = profiler.stats();
+    const ZoneStats* worker = findZone(stats, "worker zone");
+    REQUIRE(worker != nullptr);
+    REQUIRE(worker->samples == 40);
+    REQUIRE(worker->p50_ms <= worker->p99_ms);
+    REQUIRE(worker->p99_ms <= worker->max_ms);
+    REQUIRE(findZone(stats, "main zone") != nullptr);
+}
+
+TEST_CASE("Rolling statistics keep the last samples of a zone", "[Profiler]") {
+    Profiler& profiler = Profiler::instance();
+    profiler.clear();
+
+    const uint64_t MS = 1000000;
+    for (uint64_t i = 1; i <= Profiler::ROLLING_WINDOW + 10; ++i) {
+        profiler.record("rolling zone", MS, MS + i * MS);
+    }
+    profiler.collect();
+
+    auto stats = profiler.stats();
+    const ZoneStats* zone = findZone(stats, "rolling zone");
+    REQUIRE(zone != nullptr);
+    REQUIRE(zone->samples == Profiler::ROLLING_WINDOW);
+    REQUIRE(zone->max_ms == Catch::Approx(Profiler::ROLLING_WINDOW + 10));
+    REQUIRE(zone->p50_ms >= 11.0);
+}
+
+TEST_CASE("Collected zones export as Chrome trace events", "[Profiler][trace]") {
+    Profiler& profiler = Profiler::instance();
+    profiler.clear();
+
+    profiler.record("first", 1000, 3000);
+    profiler.record("second", 2000, 2500);
+    profiler.collect();
+
+    const std::string path = "profiler_test_trace.json";
+    REQUIRE(profiler.exportChromeTrace(path));
+
+    std::ifstream file(path);
+    nlohmann::json trace = nlohmann::json::parse(file);
+    file.close();
+    std::remove(path.c_str());
+
+    REQUIRE(trace["traceEvents"].size() == 2);
+    REQUIRE(trace["traceEvents"][0]["name"] == "first");
+    REQUIRE(trace["traceEvents"][0]["ph"] == "X");
+    REQUIRE(trace["traceEvents"][0]["ts"].get<double>() == Catch::Approx(0.0));
+    REQUIRE(trace["traceEvents"][0]["dur"].get<double>() == Catch::Approx(2.0));
+    REQUIRE(trace["traceEvents"][1]["ts"].get<double>() == Catch::Approx(1.0));
+}
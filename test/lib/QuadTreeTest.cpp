@@ -3,6 +3,7 @@
 #define CATCH_CONFIG_MAIN
 #include <catch2/catch_all.hpp>
 
+#include "FrameArena.hpp"
 #include "QuadTree.hpp"
 
 TEST_CASE("queries for points in the tree") {
@@ -19,3 +20,33 @@ TEST_CASE("queries for points in the tree") {
     REQUIRE(points.size() == 5);
 }
 
+
+TEST_CASE("queries into an arena return the same points") {
+    QuadTree tree({0.0f, 0.0f, 100.0f, 100.0f});
+    for (uint32_t i = 0; i < 20; ++i) {
+        tree.insert({i, i * 5.0f, i * 4.0f});
+    }
+
+    std::vector<EntityPosition> expected = tree.query({0.0f, 0.0f, 50.0f, 50.0f});
+    FrameArena arena;
+    std::pmr::vector<EntityPosition> points = tree.query({0.0f, 0.0f, 50.0f, 50.0f}, &arena);
+
+    REQUIRE(points.size() == expected.size());
+    for (size_t i = 0; i < points.size(); ++i) {
+        REQUIRE(points[i].entity == expected[i].entity);
+    }
+    REQUIRE(arena.used() > 0);
+}
+
+TEST_CASE("reset with a boundary starts an empty tree") {
+    QuadTree tree({0.0f, 0.0f, 100.0f, 100.0f});
+    for (uint32_t i = 0; i < 20; ++i) {
+        tree.insert({i, i * 5.0f, i * 4.0f});
+    }
+
+    tree.reset({0.0f, 0.0f, 200.0f, 200.0f});
+    REQUIRE(tree.query({0.0f, 0.0f, 200.0f, 200.0f}).empty());
+
+    tree.insert({0, 150.0f, 150.0f});
+    REQUIRE(tree.query({0.0f, 0.0f, 200.0f, 200.0f}).size() == 1);
+}
@@ -1,11 +1,14 @@
 // RendererTest.cpp
 
 #define CATCH_CONFIG_MAIN
+#include <algorithm>
 #include <iostream>
 #include <fstream>
 #include <catch2/catch_all.hpp>
 #include <nlohmann/json.hpp>
 
+#include "AllocationCounter.hpp"
+#include "HeadlessBackend.hpp"
 #include "Renderer.hpp"
 
 TEST_CASE("Renderer processes JSON files correctly", "[Renderer]") {
@@ -135,3 +138,213 @@ TEST_CASE("Renderer processes multiple JSON files", "[Renderer]") {
         REQUIRE(room1_pos.y == 400);
     }
 }
+
+namespace {
+
+struct AnimationState {
+    std::string name;
+    unsigned actual_frame;
+    int sprite_x;
+    int sprite_y;
+
+    bool operator==(const AnimationState&) const = default;
+};
+
+std::vector<AnimationState> runAnimation(Renderer& renderer, int32_t workers, int entities, int frames) {
+    flecs::world ecs;
+    ecs.set_threads(workers);
+    renderer.RegisterAnimationSystem(&ecs);
+
+    const auto& sprite_map = renderer.getSpriteMap();
+    std::vector<flecs::entity> spawned;
+    for (int i = 0; i < entities; ++i) {
+        // Stagger the start so entities sit on different frames
+        spawned.push_back(ecs.entity()
+            .set<Render>({ .z_index = i, .position = { 0.0f, 0.0f }, .sprite = sprite_map.at("attack/thief_0001") })
+            .set<Animation>({
+                .name = "attack/thief_0001",
+                .actual_frame = 1,
+                .total_frames = 3,
+                .current_frame = static_cast<float>(i % 5) * 0.05f }));
+    }
+
+    for (int frame = 0; frame < frames; ++frame) {
+        ecs.progress(1.0f / 60.0f);
+    }
+
+    std::vector<AnimationState> states;
+    for (auto e : spawned) {
+        const Animation* animation = e.get<Animation>();
+        const Render* render = e.get<Render>();
+        states.push_back({ animation->name, animation->actual_frame, render->sprite.x, render->sprite.y });
+    }
+    return states;
+}
+
+}  // namespace
+
+TEST_CASE("Animation system output does not depend on the worker count", "[Renderer][threads]") {
+    const std::string fixtures_path = "../test/fixtures/";
+    Renderer renderer({{CHARACTERS, fixtures_path + "characters.json"}});
+
+    const int ENTITIES = 2000;
+    const int FRAMES = 90;
+    auto single = runAnimation(renderer, 1, ENTITIES, FRAMES);
+
+    REQUIRE(single.size() == ENTITIES);
+    // The animation actually advanced
+    REQUIRE(std::any_of(single.begin(), single.end(), [](const AnimationState& s) {
+        return s.actual_frame != 1;
+    }));
+
+    for (int32_t workers : {2, 4, 8}) {
+        INFO("Workers: " << workers);
+        REQUIRE(runAnimation(renderer, workers, ENTITIES, FRAMES) == single);
+    }
+}
+
+TEST_CASE("Render system draws through the backend in z order", "[Renderer][headless]") {
+    const std::string fixtures_path = "../test/fixtures/";
+    HeadlessBackend backend;
+    Renderer renderer({{CHARACTERS, fixtures_path + "characters.json"}}, &backend);
+    renderer.LoadTextures({{CHARACTERS, "characters.png"}});
+
+    flecs::world ecs;
+    renderer.RegisterRenderSystem(&ecs);
+
+    const auto& sprite_map = renderer.getSpriteMap();
+    ecs.entity().set<Render>({ .z_index = 2, .position = { 20.0f, 0.0f }, .sprite = sprite_map.at("attack/thief_0002") });
+    ecs.entity().set<Render>({ .z_index = 1, .position = { 10.0f, 0.0f }, .sprite = sprite_map.at("attack/thief_0001") });
+
+    backend.beginFrame();
+    ecs.progress(1.0f / 60.0f);
+    backend.endFrame();
+
+    const auto& commands = backend.commands();
+    REQUIRE(commands.size() == 2);
+    REQUIRE(commands[0].op == DrawOp::TEXTURE);
+    REQUIRE(commands[0].dest.x == 10.0f);
+    REQUIRE(commands[0].source.x == 645.0f);
+    REQUIRE(commands[1].dest.x == 20.0f);
+    REQUIRE(commands[1].source.x == 525.0f);
+
+    // Same world state, same draw list
+    uint64_t hash = backend.frameHash();
+    backend.beginFrame();
+    ecs.progress(1.0f / 60.0f);
+    backend.endFrame();
+    REQUIRE(backend.frameHash() == hash);
+}
+
+TEST_CASE("Animation system does not allocate in steady state", "[Renderer][allocations]") {
+    const std::string fixtures_path = "../test/fixtures/";
+    Renderer renderer({{CHARACTERS, fixtures_path + "characters.json"}});
+
+    flecs::world ecs;
+    renderer.RegisterAnimationSystem(&ecs);
+    for (int i = 0; i < 100; ++i) {
+        ecs.entity()
+            .set<Render>({ .z_index = i, .position = { 0.0f, 0.0f }, .sprite = renderer.getSpriteMap().at("attack/thief_0001") })
+            .set<Animation>({ .name = "attack/thief_0001", .actual_frame = 1, .total_frames = 3, .current_frame = 0.0f });
+    }
+
+    // Warm up so every entity went through a frame change
+    for (int frame = 0; frame < 60; ++frame) {
+        ecs.progress(1.0f / 60.0f);
+    }
+
+    uint64_t before = heapAllocations();
+    for (int frame = 0; frame < 60; ++frame) {
+        ecs.progress(1.0f / 60.0f);
+    }
+    REQUIRE(heapAllocations() == before);
+}
+
+namespace {
+
+flecs::entity spawnThief(flecs::world& ecs, Renderer& renderer, Vector2 position) {
+    return ecs.entity()
+        .set<Render>({ .z_index = 0, .position = position, .sprite = renderer.getSpriteMap().at("attack/thief_0001") })
+        .set<Animation>({ .name = "attack/thief_0001", .actual_frame = 1, .total_frames = 3, .current_frame = 0.0f });
+}
+
+}  // namespace
+
+TEST_CASE("Animation advances by the elapsed world time", "[Renderer][lod]") {
+    const std::string fixtures_path = "../test/fixtures/";
+    Renderer renderer({{CHARACTERS, fixtures_path + "characters.json"}});
+
+    flecs::world ecs;
+    renderer.RegisterAnimationSystem(&ecs);
+    auto thief = spawnThief(ecs, renderer, { 100.0f, 100.0f });
+
+    // 0.5 s at 0.2 s per frame: two frame changes
+    for (int frame = 0; frame < 32; ++frame) {
+        ecs.progress(1.0f / 64.0f);
+    }
+
+    REQUIRE(thief.get<Animation>()->actual_frame == 3);
+    REQUIRE(thief.get<Animation>()->name == "attack/thief_0003");
+    REQUIRE(thief.get<Animation>()->current_frame == Catch::Approx(0.1f).margin(0.001f));
+    REQUIRE(thief.get<Render>()->sprite.x == renderer.getSpriteMap().at("attack/thief_0003").x);
+}
+
+TEST_CASE("Off screen animations are skipped and catch up once visible", "[Renderer][lod]") {
+    const std::string fixtures_path = "../test/fixtures/";
+    Renderer renderer({{CHARACTERS, fixtures_path + "characters.json"}});
+    renderer.setView({ 0.0f, 0.0f, 200.0f, 200.0f });
+
+    flecs::world ecs;
+    renderer.RegisterAnimationSystem(&ecs);
+    auto visible = spawnThief(ecs, renderer, { 100.0f, 100.0f });
+    auto hidden = spawnThief(ecs, renderer, { 1000.0f, 100.0f });
+
+    for (int frame = 0; frame < 20; ++frame) {
+        ecs.progress(1.0f / 64.0f);
+    }
+
+    // The hidden entity was not touched, its sprite still shows the first frame
+    REQUIRE(visible.get<Animation>()->actual_frame != 1);
+    REQUIRE(hidden.get<Animation>()->actual_frame == 1);
+    REQUIRE(hidden.get<Animation>()->name == "attack/thief_0001");
+
+    // One update brings it to the frame it would have reached animating all along
+    renderer.setView({ 0.0f, 0.0f, 2000.0f, 200.0f });
+    ecs.progress(1.0f / 64.0f);
+
+    REQUIRE(hidden.get<Animation>()->actual_frame == visible.get<Animation>()->actual_frame);
+    REQUIRE(hidden.get<Animation>()->name == visible.get<Animation>()->name);
+    REQUIRE(hidden.get<Animation>()->current_frame ==
+            Catch::Approx(visible.get<Animation>()->current_frame).margin(0.001f));
+    REQUIRE(hidden.get<Render>()->sprite.x == visible.get<Render>()->sprite.x);
+}
+
+TEST_CASE("Distant animations update at a reduced rate", "[Renderer][lod]") {
+    const std::string fixtures_path = "../test/fixtures/";
+    Renderer renderer({{CHARACTERS, fixtures_path + "characters.json"}});
+    renderer.setView({ 0.0f, 0.0f, 2000.0f, 2000.0f });
+    renderer.setAnimationLod({ .full_rate_distance = 200.0f, .reduced_interval = 4 });
+
+    flecs::world ecs;
+    renderer.RegisterAnimationSystem(&ecs);
+    auto close = spawnThief(ecs, renderer, { 1000.0f, 1000.0f });
+    auto distant = spawnThief(ecs, renderer, { 1900.0f, 1900.0f });
+
+    int distant_updates = 0;
+    float synced_at = -1.0f;
+    for (int frame = 0; frame < 64; ++frame) {
+        ecs.progress(1.0f / 64.0f);
+        if (distant.get<Animation>()->synced_at != synced_at) {
+            synced_at = distant.get<Animation>()->synced_at;
+            distant_updates++;
+        }
+    }
+    REQUIRE(close.get<Animation>()->synced_at == Catch::Approx(1.0f));
+    REQUIRE(distant_updates <= 64 / 4 + 1);
+    REQUIRE(distant_updates >= 64 / 4 - 1);
+
+    // Moving closer makes it update on the next frame and land on the frame of the close entity
+    distant.set<Render>({ .z_index = 0, .position = { 1000.0f, 1000.0f }, .sprite = distant.get<Render>()->sprite });
+    ecs.progress(1.0f / 64.0f);
+    REQUIRE(distant.get<Animation>()->actual_frame == close.get<Animation>()->actual_frame);
+}
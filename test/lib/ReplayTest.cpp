@@ -0,0 +1,194 @@
+// ReplayTest.cpp
+
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch_all.hpp>
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "Game.hpp"
+#include "HeadlessBackend.hpp"
+#include "InputLog.hpp"
+#include "Replay.hpp"
+#include "Workers.hpp"
+
+static const char* ATLAS = "../test/fixtures/characters.json";
+static const float STEP = 1.0f / 120.0f;
+
+static const unsigned SAVE_FRAME = 30;
+static const unsigned LOAD_FRAME = 90;
+
+// Holds every arrow key for a while, the way a player would. With `checkpoints` it also saves a
+// checkpoint at SAVE_FRAME and loads it back at LOAD_FRAME.
+class ScriptedInput : public IInputSource {
+ public:
+    explicit ScriptedInput(unsigned frames, bool checkpoints = false) : frames_(frames), checkpoints_(checkpoints) {}
+
+    bool poll(FrameInput* input) override {
+        if (frame_ >= frames_) return false;
+        static const uint8_t KEYS[] = {INPUT_RIGHT, INPUT_RIGHT | INPUT_DOWN, 0, INPUT_LEFT, INPUT_UP};
+        input->keys = KEYS[(frame_ / 25) % 5];
+        if (checkpoints_ && frame_ == SAVE_FRAME) input->keys |= INPUT_SAVE_CHECKPOINT;
+        if (checkpoints_ && frame_ == LOAD_FRAME) input->keys |= INPUT_LOAD_CHECKPOINT;
+        input->delta_time = STEP;
+        frame_++;
+        return true;
+    }
+
+ private:
+    unsigned frames_;
+    bool checkpoints_;
+    unsigned frame_ = 0;
+};
+
+// Runs the game loop of Main on a headless backend and records the session, `tamper` flips a bit of
+// the last checkpoint
+static std::string record(const char* name, unsigned frames, unsigned workers, bool tamper = false,
+                          bool checkpoints = false) {
+    std::string path = (std::filesystem::temp_directory_path() / name).string();
+    std::string checkpoint_path = path + ".nmws";
+
+    HeadlessBackend backend;
+    Renderer renderer({{CHARACTERS, ATLAS}}, &backend);
+    renderer.LoadTextures({{CHARACTERS, "characters.png"}});
+    flecs::world ecs;
+    ecs.set_threads(static_cast<int32_t>(workers));
+    GameState game = createGame(&ecs, &renderer);
+    renderer.Execute(&ecs);
+
+    ScriptedInput source(frames, checkpoints);
+    InputRecorder recorder(&source, path, STEP);
+    FrameInput input;
+    while (recorder.poll(&input)) {
+        updateGame(&game, input);
+        applyCheckpointInput(input, checkpoint_path, &game, &ecs);
+        backend.beginFrame();
+        ecs.progress(input.delta_time);
+        backend.endFrame();
+
+        if (recorder.frames() % CHECKPOINT_INTERVAL == 0 || recorder.frames() == frames) {
+            uint64_t hash = hashGame(game, &ecs);
+            recorder.checkpoint(tamper && recorder.frames() == frames ? hash ^ 1 : hash);
+        }
+    }
+    return path;
+}
+
+TEST_CASE("Replay reproduces a recorded session", "[Replay]") {
+    ReplayOptions options;
+    options.log = record("node_maze_session.nmil", 200, 1);
+    options.atlas = ATLAS;
+    options.workers = 1;
+
+    ReplayReport report = runReplay(options);
+
+    REQUIRE(report.error.empty());
+    REQUIRE(report.frames == 200);
+    REQUIRE(report.checkpoints == 4);
+    REQUIRE_FALSE(report.diverged);
+}
+
+TEST_CASE("Replay does not depend on the worker count", "[Replay][threads]") {
+    ReplayOptions options;
+    options.log = record("node_maze_session_threads.nmil", 150, 1);
+    options.atlas = ATLAS;
+    options.workers = 4;
+
+    ReplayReport report = runReplay(options);
+
+    REQUIRE(report.checkpoints == 3);
+    REQUIRE_FALSE(report.diverged);
+}
+
+TEST_CASE("Replay reports the first diverging checkpoint", "[Replay]") {
+    ReplayOptions options;
+    options.log = record("node_maze_session_tampered.nmil", 130, 2, true);
+    options.atlas = ATLAS;
+    options.workers = 2;
+
+    ReplayReport report = runReplay(options);
+
+    REQUIRE(report.diverged);
+    REQUIRE(report.divergence_frame == 129);
+    REQUIRE(report.checkpoints == 2);
+    REQUIRE(report.expected_hash == (report.actual_hash ^ 1));
+
+    std::ostringstream out;
+    printReplayReport(out, report);
+    REQUIRE(out.str().find("DIVERGED at frame 129") != std::string::npos);
+}
+
+TEST_CASE("Replay keeps the checkpoint keys away from the checkpoint of the player", "[Replay]") {
+    std::ofstream(CHECKPOINT_PATH) << "checkpoint of the player";
+
+    ReplayOptions options;
+    options.log = record("node_maze_session_checkpoints.nmil", 150, 1, false, true);
+    options.atlas = ATLAS;
+    options.workers = 1;
+
+    ReplayReport report = runReplay(options);
+
+    REQUIRE(report.error.empty());
+    REQUIRE(report.checkpoints == 3);
+    REQUIRE_FALSE(report.diverged);
+    std::string content;
+    std::getline(std::ifstream(CHECKPOINT_PATH), content);
+    REQUIRE(content == "checkpoint of the player");
+    std::filesystem::remove(CHECKPOINT_PATH);
+}
+
+static std::vector<char*> toArgv(std::vector<std::string>* arguments) {
+    std::vector<char*> argv;
+    for (auto& argument : *arguments) {
+        argv.push_back(argument.data());
+    }
+    return argv;
+}
+
+TEST_CASE("Replay options need a log path", "[Replay]") {
+    std::vector<std::string> arguments = {"node_maze", "--replay"};
+    std::vector<char*> argv = toArgv(&arguments);
+
+    ReplayOptions options;
+    std::string error;
+    REQUIRE(parseReplayOptions(static_cast<int>(argv.size()), argv.data(), &options, &error));
+    REQUIRE_FALSE(error.empty());
+}
+
+TEST_CASE("Replay worker count is clamped to the supported range", "[Replay]") {
+    std::vector<std::string> arguments = {"node_maze", "--replay", "session.nmil", "--workers", "1000"};
+    std::vector<char*> argv = toArgv(&arguments);
+
+    ReplayOptions options;
+    std::string error;
+    REQUIRE(parseReplayOptions(static_cast<int>(argv.size()), argv.data(), &options, &error));
+    REQUIRE(error.empty());
+    REQUIRE(options.workers == MAX_WORKERS);
+}
+
+TEST_CASE("Replay options are only validated with --replay", "[Replay]") {
+    // The worker count of a stress run is not a replay error
+    std::vector<std::string> arguments = {"node_maze", "--stress", "--workers", "0"};
+    std::vector<char*> argv = toArgv(&arguments);
+
+    ReplayOptions options;
+    std::string error;
+    REQUIRE_FALSE(parseReplayOptions(static_cast<int>(argv.size()), argv.data(), &options, &error));
+    REQUIRE(error.empty());
+}
+
+TEST_CASE("Record option needs a path", "[Replay]") {
+    std::vector<std::string> arguments = {"node_maze", "--record", "session.nmil"};
+    std::vector<char*> argv = toArgv(&arguments);
+    std::string error;
+    REQUIRE(std::string(parseRecordPath(static_cast<int>(argv.size()), argv.data(), &error)) == "session.nmil");
+    REQUIRE(error.empty());
+
+    arguments = {"node_maze", "--record"};
+    argv = toArgv(&arguments);
+    REQUIRE(parseRecordPath(static_cast<int>(argv.size()), argv.data(), &error) == nullptr);
+    REQUIRE_FALSE(error.empty());
+}
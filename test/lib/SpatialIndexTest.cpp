@@ -0,0 +1,25 @@
+// SpatialIndexTest.cpp
+
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch_all.hpp>
+
+#include "SpatialIndex.hpp"
+
+TEST_CASE("Spatial index is rebuilt from the Render positions on a job", "[SpatialIndex]") {
+    flecs::world ecs;
+    JobSystem jobs(2);
+    SpatialIndex index;
+
+    for (int i = 0; i < 50; ++i) {
+        ecs.entity().set<Render>({ .z_index = 0, .position = { i * 10.0f, i * 5.0f } });
+    }
+
+    jobs.wait(index.ExecuteAsync(&ecs, &jobs));
+    REQUIRE(index.query({ -100.0f, -100.0f, 1000.0f, 1000.0f }).size() == 50);
+    REQUIRE(index.query({ -1.0f, -1.0f, 95.0f, 95.0f }).size() == 10);
+
+    // Entities added later are picked up by the next rebuild
+    ecs.entity().set<Render>({ .z_index = 0, .position = { 2.0f, 3.0f } });
+    jobs.wait(index.ExecuteAsync(&ecs, &jobs));
+    REQUIRE(index.query({ -1.0f, -1.0f, 95.0f, 95.0f }).size() == 11);
+}
@@ -0,0 +1,113 @@
+// SpawnerTest.cpp
+
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch_all.hpp>
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "Spawner.hpp"
+
+static const Render TEMPLATE_RENDER = { .z_index = 3, .position = { 1.0f, 2.0f }, .sprite = { .width = 26, .height = 61 } };
+static const Animation TEMPLATE_ANIMATION = {
+    .name = "attack/thief_0001", .actual_frame = 1, .total_frames = 3, .current_frame = 0.0f };
+
+TEST_CASE("Spawner creates entities from contiguous arrays", "[Spawner]") {
+    flecs::world ecs;
+    Spawner spawner(&ecs);
+    flecs::entity prefab = spawner.prefab("Thief", TEMPLATE_RENDER, TEMPLATE_ANIMATION);
+
+    std::vector<Render> renders(1000, TEMPLATE_RENDER);
+    std::vector<Animation> animations(1000, TEMPLATE_ANIMATION);
+    for (size_t i = 0; i < renders.size(); ++i) {
+        renders[i].position = { static_cast<float>(i), static_cast<float>(2 * i) };
+        // Longer than the small string buffer, a moved-from name would be empty
+        animations[i].name = "job1/w_blonde_" + std::to_string(i);
+        animations[i].actual_frame = static_cast<unsigned>(i % 3) + 1;
+    }
+    const std::vector<Animation> expected = animations;
+
+    auto entities = spawner.spawn(prefab, renders, animations);
+
+    REQUIRE(entities.size() == 1000);
+    // The prefab itself is not matched by queries
+    REQUIRE(ecs.count<Render>() == 1000);
+    for (size_t i = 0; i < entities.size(); ++i) {
+        flecs::entity entity = ecs.entity(entities[i]);
+        REQUIRE(entity.has(flecs::IsA, prefab));
+        REQUIRE(entity.owns<Render>());
+        REQUIRE(entity.owns<Animation>());
+        REQUIRE(entity.get<Render>()->position.x == static_cast<float>(i));
+        REQUIRE(entity.get<Render>()->position.y == static_cast<float>(2 * i));
+        REQUIRE(entity.get<Animation>()->name == expected[i].name);
+        REQUIRE(entity.get<Animation>()->actual_frame == expected[i].actual_frame);
+        // The const overload copies, the caller keeps its data
+        REQUIRE(animations[i].name == expected[i].name);
+    }
+}
+
+TEST_CASE("Spawner moves the animations handed over as rvalue", "[Spawner]") {
+    flecs::world ecs;
+    Spawner spawner(&ecs);
+
+    std::vector<Render> renders(10, TEMPLATE_RENDER);
+    std::vector<Animation> animations(10, TEMPLATE_ANIMATION);
+    for (size_t i = 0; i < animations.size(); ++i) {
+        animations[i].name = "job1/character_with_a_long_name_" + std::to_string(i);
+    }
+    const std::vector<Animation> expected = animations;
+
+    auto entities = spawner.spawn(renders, std::move(animations));
+
+    REQUIRE(entities.size() == 10);
+    for (size_t i = 0; i < entities.size(); ++i) {
+        REQUIRE(ecs.entity(entities[i]).get<Animation>()->name == expected[i].name);
+    }
+}
+
+TEST_CASE("Spawner rejects arrays of different sizes", "[Spawner]") {
+    flecs::world ecs;
+    Spawner spawner(&ecs);
+    flecs::entity prefab = spawner.prefab("Thief", TEMPLATE_RENDER, TEMPLATE_ANIMATION);
+
+    std::vector<Render> renders(10, TEMPLATE_RENDER);
+    std::vector<Animation> animations(9, TEMPLATE_ANIMATION);
+
+    REQUIRE_THROWS_AS(spawner.spawn(prefab, renders, animations), std::invalid_argument);
+    REQUIRE_THROWS_AS(spawner.spawn(renders, animations), std::invalid_argument);
+    REQUIRE(ecs.count<Render>() == 0);
+}
+
+TEST_CASE("Spawner keeps the prefab values of missing arrays", "[Spawner]") {
+    flecs::world ecs;
+    Spawner spawner(&ecs);
+    flecs::entity prefab = spawner.prefab("Thief", TEMPLATE_RENDER, TEMPLATE_ANIMATION);
+
+    std::vector<Render> renders(10, TEMPLATE_RENDER);
+    renders[7].z_index = 42;
+    auto positioned = spawner.spawn(prefab, renders);
+    auto copies = spawner.spawn(prefab, 5);
+
+    REQUIRE(positioned.size() == 10);
+    REQUIRE(copies.size() == 5);
+    REQUIRE(ecs.entity(positioned[7]).get<Render>()->z_index == 42);
+    REQUIRE(ecs.entity(positioned[7]).get<Animation>()->name == "attack/thief_0001");
+    REQUIRE(ecs.entity(copies[4]).get<Render>()->z_index == 3);
+
+    // Instances own their copy, changing one does not touch the prefab or the others
+    ecs.entity(copies[0]).get_mut<Animation>()->actual_frame = 2;
+    REQUIRE(prefab.get<Animation>()->actual_frame == 1);
+    REQUIRE(ecs.entity(copies[1]).get<Animation>()->actual_frame == 1);
+}
+
+TEST_CASE("Spawned entities share one archetype table", "[Spawner]") {
+    flecs::world ecs;
+    Spawner spawner(&ecs);
+    flecs::entity prefab = spawner.prefab("Thief", TEMPLATE_RENDER, TEMPLATE_ANIMATION);
+
+    auto entities = spawner.spawn(prefab, 100);
+
+    REQUIRE(ecs_get_table(ecs.c_ptr(), entities.front()) == ecs_get_table(ecs.c_ptr(), entities.back()));
+    REQUIRE(spawner.spawn(prefab, 0).empty());
+}
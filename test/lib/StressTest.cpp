@@ -0,0 +1,118 @@
+// StressTest.cpp
+
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch_all.hpp>
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "Stress.hpp"
+#include "Workers.hpp"
+
+static bool parse(std::vector<std::string> arguments, StressOptions* options, std::string* error) {
+    std::vector<char*> argv;
+    for (auto& argument : arguments) {
+        argv.push_back(argument.data());
+    }
+    return parseStressOptions(static_cast<int>(argv.size()), argv.data(), options, error);
+}
+
+TEST_CASE("Stress options are only parsed with --stress", "[Stress]") {
+    StressOptions options;
+    std::string error;
+
+    REQUIRE_FALSE(parse({"node_maze"}, &options, &error));
+    REQUIRE(error.empty());
+
+    // Arguments meant for another mode are not validated without --stress
+    REQUIRE_FALSE(parse({"node_maze", "--replay", "session.nmil", "--frames", "all"}, &options, &error));
+    REQUIRE(error.empty());
+}
+
+TEST_CASE("Stress options read the entity, frame and worker counts", "[Stress]") {
+    StressOptions options;
+    std::string error;
+
+    REQUIRE(parse({"node_maze", "--stress", "--entities", "500", "--frames", "20", "--workers", "2"},
+                  &options, &error));
+    REQUIRE(error.empty());
+    REQUIRE(options.entities == 500);
+    REQUIRE(options.frames == 20);
+    REQUIRE(options.workers == 2);
+}
+
+TEST_CASE("Stress worker count is clamped to the supported range", "[Stress]") {
+    StressOptions options;
+    std::string error;
+
+    REQUIRE(parse({"node_maze", "--stress", "--workers", "1000"}, &options, &error));
+    REQUIRE(error.empty());
+    REQUIRE(options.workers == MAX_WORKERS);
+}
+
+TEST_CASE("Invalid stress options are reported", "[Stress]") {
+    StressOptions options;
+    std::string error;
+
+    REQUIRE(parse({"node_maze", "--stress", "--entities", "many"}, &options, &error));
+    REQUIRE_FALSE(error.empty());
+
+    error.clear();
+    REQUIRE(parse({"node_maze", "--stress", "--frames"}, &options, &error));
+    REQUIRE_FALSE(error.empty());
+}
+
+TEST_CASE("Stress run reports the throughput of the frame pipeline", "[Stress][headless]") {
+    StressOptions options;
+    options.entities = 200;
+    options.frames = 30;
+    options.workers = 2;
+    options.atlas = "../test/fixtures/characters.json";
+
+    StressReport report = runStress(options);
+
+    REQUIRE(report.error.empty());
+    REQUIRE(report.entities == 200);
+    REQUIRE(report.frames == 30);
+    REQUIRE(report.frames_per_second > 0.0);
+    REQUIRE(report.entities_per_second == Catch::Approx(report.frames_per_second * 200));
+    REQUIRE(report.p50_ms <= report.p99_ms);
+    REQUIRE(report.p99_ms <= report.max_ms);
+    REQUIRE(report.last_frame_hash != 0);
+    // Steady state frames reuse the arenas, the pooled jobs and the command buffers
+    REQUIRE(report.heap_allocations_per_frame < 1.0);
+    // 200 entities on a 15 x 15 grid 16 pixels apart, all inside the view
+    REQUIRE(report.visible_entities == 200);
+
+    std::ostringstream out;
+    printStressReport(out, report);
+    REQUIRE(out.str().find("200 entities, 30 frames") != std::string::npos);
+}
+
+TEST_CASE("Stress run fails on an atlas without animations", "[Stress][headless]") {
+    StressOptions options;
+    options.entities = 10;
+    options.frames = 2;
+    options.atlas = "../test/fixtures/missing.json";
+
+    StressReport report = runStress(options);
+
+    REQUIRE_FALSE(report.error.empty());
+    REQUIRE(report.frames == 0);
+    std::ostringstream out;
+    printStressReport(out, report);
+    REQUIRE(out.str().find("failed") != std::string::npos);
+}
+
+TEST_CASE("Stress runs draw the same frame with any worker count", "[Stress][threads]") {
+    StressOptions options;
+    options.entities = 300;
+    options.frames = 40;
+    options.atlas = "../test/fixtures/characters.json";
+
+    options.workers = 1;
+    uint64_t single = runStress(options).last_frame_hash;
+    options.workers = 4;
+    REQUIRE(runStress(options).last_frame_hash == single);
+}
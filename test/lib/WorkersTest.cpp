@@ -0,0 +1,26 @@
+// WorkersTest.cpp
+
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch_all.hpp>
+
+#include "Workers.hpp"
+
+TEST_CASE("Worker count is parsed from the requested value", "[Workers]") {
+    REQUIRE(resolveWorkerCount("1") == 1);
+    REQUIRE(resolveWorkerCount("4") == 4);
+}
+
+TEST_CASE("Worker count is clamped to the supported range", "[Workers]") {
+    REQUIRE(resolveWorkerCount("1000") == MAX_WORKERS);
+    REQUIRE(resolveWorkerCount("0") >= 1);
+    REQUIRE(resolveWorkerCount("-3") >= 1);
+}
+
+TEST_CASE("Invalid worker counts fall back to the hardware concurrency", "[Workers]") {
+    unsigned fallback = resolveWorkerCount(nullptr);
+    REQUIRE(fallback >= 1);
+    REQUIRE(fallback <= MAX_WORKERS);
+    REQUIRE(resolveWorkerCount("") == fallback);
+    REQUIRE(resolveWorkerCount("four") == fallback);
+    REQUIRE(resolveWorkerCount("4x") == fallback);
+}
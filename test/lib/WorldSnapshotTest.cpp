@@ -0,0 +1,232 @@
+// WorldSnapshotTest.cpp
+
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch_all.hpp>
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "Renderer.hpp"
+#include "Spawner.hpp"
+#include "WorldSnapshot.hpp"
+
+static const unsigned ENTITIES = 300;
+
+static std::string snapshotPath(const char* name) {
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+
+// Entities with a unique z index each, keyed by it so worlds can be compared
+static void spawnLevel(flecs::world* ecs) {
+    std::vector<Render> renders(ENTITIES);
+    std::vector<Animation> animations(ENTITIES);
+    for (unsigned i = 0; i < ENTITIES; ++i) {
+        renders[i] = {
+            .z_index = static_cast<int>(i),
+            .position = { static_cast<float>(i % 20) * 16.0f, static_cast<float>(i / 20) * 16.0f },
+            .sprite = { .width = 26, .height = 61, .x = static_cast<int>(i), .y = 7 } };
+        animations[i] = {
+            .name = "job1/character_with_a_long_name_" + std::to_string(i) + "_0001",
+            .actual_frame = i % 8 + 1,
+            .total_frames = 8,
+            .current_frame = static_cast<float>(i % 10) * 0.01f };
+    }
+    Spawner(ecs).spawn(renders, animations);
+}
+
+static std::map<int, std::pair<Render, Animation>> collect(flecs::world* ecs) {
+    std::map<int, std::pair<Render, Animation>> entities;
+    ecs->each([&entities](const Render& render, const Animation& animation) {
+        entities[render.z_index] = {render, animation};
+    });
+    return entities;
+}
+
+static QuadTree buildTree(flecs::world* ecs) {
+    QuadTree tree({-20.0f, -20.0f, 400.0f, 300.0f});
+    ecs->each([&tree](flecs::entity entity, const Render& render) {
+        tree.insert({static_cast<uint32_t>(entity.id()), render.position.x, render.position.y});
+    });
+    return tree;
+}
+
+static FloydWarshal buildPaths() {
+    FloydWarshal paths(16);
+    for (unsigned node = 0; node < 15; ++node) {
+        paths.addEdgeWithMapping(100 + node, 100 + node + 1, node % 3 + 1);
+    }
+    paths.addEdgeWithMapping(115, 100, 1);
+    paths.generate();
+    return paths;
+}
+
+TEST_CASE("World snapshot restores the entities and the derived structures", "[WorldSnapshot]") {
+    flecs::world source;
+    spawnLevel(&source);
+    QuadTree tree = buildTree(&source);
+    FloydWarshal paths = buildPaths();
+
+    std::string path = snapshotPath("node_maze_level.nmws");
+    std::string error;
+    REQUIRE(WorldSnapshot::save(path, &source, &tree, &paths, {}, &error));
+
+    flecs::world target;
+    // Entities created first shift the ids, the tree has to be remapped
+    for (int i = 0; i < 50; ++i) target.entity();
+    QuadTree loaded_tree({0.0f, 0.0f, 0.0f, 0.0f});
+    FloydWarshal loaded_paths(1);
+    REQUIRE(WorldSnapshot::load(path, &target, &loaded_tree, &loaded_paths, {}, &error));
+
+    auto expected = collect(&source);
+    auto actual = collect(&target);
+    REQUIRE(actual.size() == ENTITIES);
+    for (const auto& [z_index, components] : expected) {
+        INFO("Entity " << z_index);
+        const auto& [render, animation] = actual.at(z_index);
+        REQUIRE(render.position.x == components.first.position.x);
+        REQUIRE(render.position.y == components.first.position.y);
+        REQUIRE(render.sprite.x == components.first.sprite.x);
+        REQUIRE(render.sprite.width == components.first.sprite.width);
+        REQUIRE(animation.name == components.second.name);
+        REQUIRE(animation.actual_frame == components.second.actual_frame);
+        REQUIRE(animation.current_frame == components.second.current_frame);
+    }
+
+    // Tree entries point at the new entities, at their positions
+    auto found = loaded_tree.query({-20.0f, -20.0f, 400.0f, 300.0f});
+    REQUIRE(found.size() == ENTITIES);
+    for (const auto& point : found) {
+        flecs::entity entity = target.entity(static_cast<flecs::entity_t>(point.entity));
+        REQUIRE(entity.is_alive());
+        REQUIRE(entity.get<Render>()->position.x == point.x);
+        REQUIRE(entity.get<Render>()->position.y == point.y);
+    }
+
+    REQUIRE(loaded_paths.getSize() == paths.getSize());
+    for (unsigned u = 100; u < 116; ++u) {
+        for (unsigned v = 100; v < 116; ++v) {
+            REQUIRE(loaded_paths.valueWithMapping(u, v) == paths.valueWithMapping(u, v));
+            REQUIRE(loaded_paths.nextWithMapping(u, v) == paths.nextWithMapping(u, v));
+        }
+    }
+}
+
+TEST_CASE("Loading a snapshot replaces the entities of the world", "[WorldSnapshot]") {
+    flecs::world source;
+    spawnLevel(&source);
+    std::string path = snapshotPath("node_maze_replace.nmws");
+    std::string error;
+    REQUIRE(WorldSnapshot::save(path, &source, nullptr, nullptr, {}, &error));
+
+    REQUIRE(WorldSnapshot::load(path, &source, nullptr, nullptr, {}, &error));
+    REQUIRE(WorldSnapshot::load(path, &source, nullptr, nullptr, {}, &error));
+    REQUIRE(source.count<Render>() == ENTITIES);
+}
+
+TEST_CASE("Loading a snapshot keeps the entities it does not cover", "[WorldSnapshot]") {
+    flecs::world source;
+    spawnLevel(&source);
+    Spawner spawner(&source);
+    flecs::entity prefab = spawner.prefab("Character", { .z_index = -1 }, { .name = "job1/m_bald_0001" });
+    std::vector<Render> instance_renders = { { .z_index = -2 } };
+    spawner.spawn(prefab, instance_renders);
+    flecs::entity marker = source.entity().set<Render>({ .z_index = -3 });
+
+    std::string path = snapshotPath("node_maze_partial.nmws");
+    std::string error;
+    REQUIRE(WorldSnapshot::save(path, &source, nullptr, nullptr, {}, &error));
+    REQUIRE(WorldSnapshot::load(path, &source, nullptr, nullptr, {}, &error));
+
+    // The instance is saved and restored as a plain entity, the prefab and the Render-only entity stay
+    REQUIRE(prefab.is_alive());
+    REQUIRE(prefab.get<Animation>()->name == "job1/m_bald_0001");
+    REQUIRE(marker.is_alive());
+    REQUIRE(marker.get<Render>()->z_index == -3);
+    auto restored = collect(&source);
+    REQUIRE(restored.size() == ENTITIES + 1);
+    REQUIRE(restored.at(-2).second.name == "job1/m_bald_0001");
+    REQUIRE(source.count<Render>() == ENTITIES + 2);
+}
+
+TEST_CASE("Animation timestamps follow the world time of the loading world", "[WorldSnapshot]") {
+    const std::string fixtures_path = "../test/fixtures/";
+    Renderer renderer({{CHARACTERS, fixtures_path + "characters.json"}});
+
+    flecs::world source;
+    renderer.RegisterAnimationSystem(&source);
+    flecs::entity thief = source.entity()
+        .set<Render>({ .z_index = 0, .position = { 0.0f, 0.0f }, .sprite = renderer.getSpriteMap().at("attack/thief_0001") })
+        .set<Animation>({ .name = "attack/thief_0001", .actual_frame = 1, .total_frames = 3, .current_frame = 0.0f });
+    for (int frame = 0; frame < 40; ++frame) {
+        source.progress(1.0f / 64.0f);
+    }
+    REQUIRE(thief.get<Animation>()->synced_at == Catch::Approx(40.0f / 64.0f));
+
+    std::string path = snapshotPath("node_maze_time.nmws");
+    std::string error;
+    REQUIRE(WorldSnapshot::save(path, &source, nullptr, nullptr, {}, &error));
+
+    flecs::world target;
+    renderer.RegisterAnimationSystem(&target);
+    target.progress(1.0f / 64.0f);
+    REQUIRE(WorldSnapshot::load(path, &target, nullptr, nullptr, {}, &error));
+
+    // One frame later on both worlds gives the same animation state
+    source.progress(1.0f / 64.0f);
+    target.progress(1.0f / 64.0f);
+    auto expected = collect(&source).at(0).second;
+    auto actual = collect(&target).at(0).second;
+    REQUIRE(actual.actual_frame == expected.actual_frame);
+    REQUIRE(actual.current_frame == Catch::Approx(expected.current_frame).margin(0.001f));
+    REQUIRE(actual.synced_at == Catch::Approx(2.0f / 64.0f));
+}
+
+TEST_CASE("Invalid snapshots are rejected without touching the world", "[WorldSnapshot]") {
+    flecs::world source;
+    spawnLevel(&source);
+    std::string path = snapshotPath("node_maze_valid.nmws");
+    std::string error;
+    REQUIRE(WorldSnapshot::save(path, &source, nullptr, nullptr, {}, &error));
+
+    // Header and directory only, the blocks are cut off
+    std::string truncated = snapshotPath("node_maze_truncated.nmws");
+    {
+        std::ifstream in(path, std::ios::binary);
+        std::vector<char> bytes(200);
+        in.read(bytes.data(), bytes.size());
+        std::ofstream(truncated, std::ios::binary).write(bytes.data(), bytes.size());
+    }
+    std::string not_a_snapshot = snapshotPath("node_maze_not_a_snapshot.nmws");
+    std::ofstream(not_a_snapshot) << "{\"frames\": []}";
+
+    for (const std::string& invalid : {truncated, not_a_snapshot, snapshotPath("node_maze_missing.nmws")}) {
+        INFO(invalid);
+        error.clear();
+        REQUIRE_FALSE(WorldSnapshot::load(invalid, &source, nullptr, nullptr, {}, &error));
+        REQUIRE_FALSE(error.empty());
+        REQUIRE(source.count<Render>() == ENTITIES);
+    }
+}
+
+TEST_CASE("World snapshot carries the user data of the application", "[WorldSnapshot]") {
+    flecs::world source;
+    spawnLevel(&source);
+    std::string path = snapshotPath("node_maze_user_data.nmws");
+    std::string error;
+    const uint8_t saved[] = {1, 2, 3, 4, 5, 6, 7, 8};
+    REQUIRE(WorldSnapshot::save(path, &source, nullptr, nullptr, saved, &error));
+
+    uint8_t loaded[8] = {};
+    REQUIRE(WorldSnapshot::load(path, &source, nullptr, nullptr, loaded, &error));
+    REQUIRE(std::equal(std::begin(saved), std::end(saved), std::begin(loaded)));
+
+    // Another size means another layout, the world stays as it is
+    uint8_t longer[12] = {};
+    source.entity().set<Render>({ .z_index = -1 }).set<Animation>({ .name = "job1/m_bald_0001" });
+    REQUIRE_FALSE(WorldSnapshot::load(path, &source, nullptr, nullptr, longer, &error));
+    REQUIRE(source.count<Render>() == ENTITIES + 1);
+}